@@ -1,23 +1,99 @@
 #ifndef _OOCMD_APPLICATION_HPP
 #define _OOCMD_APPLICATION_HPP
 
+#include <cmath>
 #include <concepts>
+#include <condition_variable>
 #include <cstddef>
 #include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include <nlohmann/json.hpp>
 
+#include <oocmd/choice.hpp>
 #include <oocmd/config_object.hpp>
+#include <oocmd/control_server.hpp>
+#include <oocmd/event_loop.hpp>
+#include <oocmd/lazy.hpp>
+#include <oocmd/options.hpp>
+#include <oocmd/param_handle.hpp>
+#include <oocmd/parser.hpp>
+#include <oocmd/provenance.hpp>
+#include <oocmd/profiler.hpp>
+#include <oocmd/specialized.hpp>
+#include <oocmd/task.hpp>
+#include <oocmd/thread_pool.hpp>
+#include <oocmd/util/arena.hpp>
+#include <oocmd/util/config_file.hpp>
 #include <oocmd/util/match_config.hpp>
 #include <oocmd/util/parse_cmdline.hpp>
+#include <oocmd/util/resource_usage.hpp>
+#include <oocmd/util/statistics.hpp>
+#include <oocmd/util/sweep.hpp>
 #include <oocmd/util/usage.hpp>
 
 namespace oocmd {
 
+class Application;
+
+/**
+ * \brief Requires a type to be a valid result of a \c run function, i.e., an integer return code or a \ref Task producing one
+ *
+ * \tparam R the result type
+ */
+template<typename R>
+concept RunResult = std::convertible_to<R, int> || (is_task_v<R> && std::convertible_to<typename R::value_type, int>);
+
+/**
+ * \brief Requires a config object type to be runnable by an \ref Application
+ *
+ * A config object is runnable if it has a function \c run that accepts a reference to the application and returns an integer return code.
+ * The function may also be a coroutine returning a \ref Task that produces the return code, which is then driven by an \ref EventLoop (see \ref Application::loop ).
+ *
+ * \tparam T the config object type
+ */
+template<typename T>
+concept Runnable = requires(T x, Application const& app) {
+    { x.run(app) } -> RunResult;
+};
+
+// invokes the run function of a dispatching config object with the selected alternative
+template<typename T>
+struct DispatchRun {
+    T& x;
+    Application const& app;
+
+    template<typename Alternative>
+    requires requires(T& x, Application const& app, Alternative&& alt) {
+        { x.run(app, std::forward<Alternative>(alt)) } -> RunResult;
+    }
+    inline decltype(auto) operator()(Alternative&& alt) const { return x.run(app, std::forward<Alternative>(alt)); }
+};
+
+/**
+ * \brief Requires a config object type to be runnable by an \ref Application via dispatch to its selected alternative
+ *
+ * A config object is dispatchable if it has a function \c dispatch that returns a reference to a \ref Choice or a \ref Specialized value,
+ * and a function template \c run that accepts a reference to the application and the selected alternative and returns an integer return code, or a \ref Task producing one.
+ * The \c run function is instantiated for each alternative, i.e., for each choice or for each specialized value as well as the generic value type.
+ *
+ * \tparam T the config object type
+ */
+template<typename T>
+concept Dispatchable = requires(T x, DispatchRun<T> const& f) {
+    { x.dispatch().visit(f) } -> std::convertible_to<int>;
+};
+
 /**
  * \brief Parses the command line and configures a \ref ConfigObject
  * 
@@ -49,7 +125,7 @@ namespace oocmd {
  */
 class Application : public ConfigObject {
 private:
-    inline static bool report_errors(std::vector<std::string> const& errors) {
+    inline static bool report_errors(ErrorList const& errors) {
         if(!errors.empty()) {
             for(auto& e : errors) {
                 std::cerr << e << std::endl;
@@ -67,6 +143,497 @@ private:
     std::vector<std::string> args_;
 
     bool help_ = false;
+    Options options_;
+
+    std::unique_ptr<Arena> arena_; // the arena used while parsing the command line
+    ArenaStats arena_stats_;
+
+    inline static std::function<void(ArenaStats const&)>& arena_hook() {
+        static std::function<void(ArenaStats const&)> hook;
+        return hook;
+    }
+
+    nlohmann::json config_;             // the configuration matched for the configured object, unless it is run only once
+    std::vector<SweepDimension> sweep_; // the dimensions of a parameter sweep, if any
+
+    // reports the profiled phases as requested by the standard options, embedding the given configuration into the trace
+    inline void report_profile(nlohmann::json const& config) const {
+        if(!profiler_->enabled()) return;
+
+        if(options_.profile) {
+            std::cerr << "Profile:" << std::endl;
+            profiler_->print_tree(std::cerr);
+        }
+
+        if(!options_.trace.empty()) {
+            std::ofstream trace(options_.trace);
+            if(trace) {
+                profiler_->write_trace(trace, config);
+            } else {
+                std::cerr << "failed to open trace file: " << options_.trace << std::endl;
+            }
+        }
+    }
+
+    // runs the given config object, dispatching if necessary, and drives an asynchronous run to completion on an event loop
+    template<DerivedFromConfigObject T>
+    requires Runnable<T> || Dispatchable<T>
+    inline static int run_object(T& x, Application const& app) {
+        auto invoke = [&]() -> decltype(auto) {
+            if constexpr(Dispatchable<T>) {
+                return x.dispatch().visit(DispatchRun<T>{ x, app });
+            } else {
+                return x.run(app);
+            }
+        };
+
+        if constexpr(is_task_v<std::remove_cvref_t<decltype(invoke())>>) {
+            EventLoop loop;
+            RunContextScope scope;
+            current_run().loop = &loop;
+            auto task = invoke();
+            auto const completed = loop.run(task);
+
+            if(!completed) {
+                std::cerr << (loop.good() ? "asynchronous run stalled without pending timers or file descriptors" : "failed to create event loop") << std::endl;
+                return -1;
+            }
+            return task.result();
+        } else {
+            return invoke();
+        }
+    }
+
+    // runs the given config object, recording measurements made on the current thread into the given measurements, and writes a result line if requested
+    template<DerivedFromConfigObject T>
+    requires Runnable<T> || Dispatchable<T>
+    inline int run_recorded(T& x, Measurements& measurements, bool const write_result) const {
+        int return_code;
+        {
+            RunContextScope scope;
+            current_run().measurements = &measurements;
+            return_code = run_object(x, *this);
+        }
+
+        std::string error;
+        if(write_result && !measurements.empty() && !result_sink_->write(x.config(), measurements, &error)) {
+            std::cerr << "failed to write result line to " << (options_.results.empty() ? "standard output" : options_.results) << ": " << error << std::endl;
+        }
+        return return_code;
+    }
+
+    // configures and runs a fresh config object, repeatedly if benchmarking, and reports the configuration, return code and any benchmark results
+    template<DerivedFromConfigObject T>
+    requires (Runnable<T> || Dispatchable<T>) && std::default_initializable<T>
+    inline nlohmann::json run_configured(nlohmann::json const& config) const {
+        nlohmann::json result;
+        if(options_.repeat == 0) {
+            T x;
+            x.configure(config);
+            result["config"] = x.config();
+
+            Measurements measurements;
+            result["return"] = run_recorded(x, measurements, true);
+            return result;
+        }
+
+        {
+            T x;
+            x.configure(config);
+            result["config"] = x.config();
+        }
+
+        // warm up, stopping at the first failure
+        int return_code = 0;
+        for(unsigned int i = 0; i < options_.warmup && return_code == 0; i++) {
+            T x;
+            x.configure(config);
+            Measurements measurements;
+            return_code = run_recorded(x, measurements, false);
+        }
+
+        // measure each run on a freshly configured object, stopping at the first failure
+        std::vector<ResourceUsage> iterations;
+        for(unsigned int i = 0; i < options_.repeat && return_code == 0; i++) {
+            T x;
+            x.configure(config);
+
+            Measurements measurements;
+            ResourceUsage usage;
+            return_code = measure([&]{ return run_recorded(x, measurements, true); }, usage);
+            iterations.push_back(usage);
+        }
+        result["return"] = return_code;
+
+        // summarize
+        nlohmann::json iterations_json = nlohmann::json::array();
+        for(auto const& usage : iterations) iterations_json.push_back(usage.to_json());
+
+        auto summarize_metric = [&](auto metric) {
+            std::vector<double> values;
+            values.reserve(iterations.size());
+            for(auto const& usage : iterations) values.push_back(double(usage.*metric));
+            return summarize(std::move(values)).to_json();
+        };
+
+        result["iterations"] = std::move(iterations_json);
+        result["statistics"] = {
+            { "wall", summarize_metric(&ResourceUsage::wall) },
+            { "user", summarize_metric(&ResourceUsage::user) },
+            { "system", summarize_metric(&ResourceUsage::system) },
+            { "max_rss", summarize_metric(&ResourceUsage::max_rss) },
+            { "minor_faults", summarize_metric(&ResourceUsage::minor_faults) },
+            { "major_faults", summarize_metric(&ResourceUsage::major_faults) },
+        };
+        return result;
+    }
+
+    // searches the tunable parameters for the best configuration by running fresh config objects, and writes the best configuration
+    template<DerivedFromConfigObject T>
+    requires (Runnable<T> || Dispatchable<T>) && std::default_initializable<T>
+    inline int run_tune() const {
+        std::vector<SweepDimension> dims;
+        {
+            T x;
+            collect_tunables(x, config_, {}, dims);
+        }
+
+        std::vector<size_t> dim_sizes;
+        for(auto const& dim : dims) dim_sizes.push_back(dim.values.size());
+
+        size_t evaluation = 0;
+        auto objective = [&](Autotuner::Point const& point) {
+            auto const config = assign_point(config_, dims, point);
+
+            T x;
+            x.configure(config);
+
+            Measurements measurements;
+            ResourceUsage usage;
+            auto const return_code = measure([&]{ return run_recorded(x, measurements, false); }, usage);
+
+            auto v = std::numeric_limits<double>::infinity();
+            if(return_code == 0) {
+                if(options_.tune_objective.empty()) {
+                    v = usage.wall;
+                } else {
+                    for(auto const& [key, value] : measurements.values()) {
+                        if(key == options_.tune_objective && value.is_number()) {
+                            double const measured = value;
+                            v = options_.tune_maximize ? -measured : measured;
+                        }
+                    }
+                }
+            }
+
+            nlohmann::json log;
+            log["evaluation"] = evaluation++;
+            log["config"] = x.config();
+            log["return"] = return_code;
+            log["objective"] = std::isfinite(v) ? nlohmann::json(options_.tune_maximize ? -v : v) : nlohmann::json();
+            std::cerr << log.dump() << std::endl;
+            return v;
+        };
+
+        Autotuner tuner(dim_sizes, options_.tune_strategy, options_.tune, options_.tune_seed);
+        Autotuner::Point best;
+        if(!std::isfinite(tuner.tune(objective, best))) {
+            std::cerr << "autotuning found no successful configuration" << std::endl;
+            return -1;
+        }
+
+        // write the best configuration
+        nlohmann::json best_config;
+        {
+            T x;
+            x.configure(assign_point(config_, dims, best));
+            best_config = x.config();
+        }
+
+        if(options_.tune_output.empty()) {
+            std::cout << best_config.dump(4) << std::endl;
+        } else {
+            std::ofstream out(options_.tune_output);
+            if(!(out << best_config.dump(4) << std::endl)) {
+                std::cerr << "failed to write tuned configuration to: " << options_.tune_output << std::endl;
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    // runs a fresh config object for each point of the parameter sweep and reports the configuration and return code of each run in order
+    template<DerivedFromConfigObject T>
+    requires (Runnable<T> || Dispatchable<T>) && std::default_initializable<T>
+    inline int run_sweep() const {
+        auto const points = sweep_points(config_, sweep_);
+
+        std::ofstream file;
+        if(!options_.sweep_output.empty()) {
+            file.open(options_.sweep_output);
+            if(!file) {
+                std::cerr << "failed to open sweep output file: " << options_.sweep_output << std::endl;
+                return -1;
+            }
+        }
+        std::ostream& out = file.is_open() ? file : std::cout;
+
+        // results are reported in order as soon as all preceding runs have completed
+        std::vector<nlohmann::json> results(points.size());
+        std::vector<bool> completed(points.size(), false);
+        size_t next_report = 0;
+        int return_code = 0;
+        std::mutex mutex;
+
+        auto run_point = [&](size_t const i) {
+            auto result = run_configured<T>(points[i]);
+
+            std::lock_guard lock(mutex);
+            results[i] = std::move(result);
+            completed[i] = true;
+            while(next_report < points.size() && completed[next_report]) {
+                auto const& r = results[next_report];
+                if(return_code == 0) return_code = r["return"].get<int>();
+                out << r.dump() << std::endl;
+                results[next_report] = nlohmann::json();
+                ++next_report;
+            }
+        };
+
+        // benchmarks measure the resource usage of the whole process, so their runs must not overlap
+        auto const jobs = options_.repeat > 0 ? 1u : (options_.jobs ? options_.jobs : machine::available_cores());
+        if(jobs <= 1) {
+            for(size_t i = 0; i < points.size(); i++) run_point(i);
+        } else {
+            ThreadPool sweep_pool(std::min(size_t(jobs), points.size()));
+            sweep_pool.parallel_for(0, points.size(), run_point, 1);
+        }
+        return return_code;
+    }
+
+    // runs a fresh config object for each command line read from the job file and reports the configuration, return code and output of each job in order
+    template<DerivedFromConfigObject T>
+    requires (Runnable<T> || Dispatchable<T>) && std::default_initializable<T>
+    inline int run_batch() const {
+        std::ifstream job_file;
+        if(options_.batch != "-") {
+            job_file.open(options_.batch);
+            if(!job_file) {
+                std::cerr << "failed to open job file: " << options_.batch << std::endl;
+                return -1;
+            }
+        }
+        std::istream& in = job_file.is_open() ? job_file : std::cin;
+
+        std::ofstream file;
+        if(!options_.batch_output.empty()) {
+            file.open(options_.batch_output);
+            if(!file) {
+                std::cerr << "failed to open batch output file: " << options_.batch_output << std::endl;
+                return -1;
+            }
+        }
+        std::ostream& out = file.is_open() ? file : std::cout;
+
+        // results are reported in order as soon as all preceding jobs have completed
+        // at most window jobs are in flight, so that reading the job file is throttled to the pace of execution and pending results are bounded
+        auto const parallel = options_.parallel ? options_.parallel : machine::available_cores();
+        auto const window = 2 * size_t(parallel);
+        std::vector<std::optional<nlohmann::json>> results(window);
+        size_t next_report = 0;
+        int return_code = 0;
+        std::mutex mutex;
+        std::condition_variable reported;
+
+        auto run_job = [&](size_t const i, size_t const line_number, std::string const& line) {
+            nlohmann::json result;
+            result["job"] = i;
+            result["line"] = line_number;
+            try {
+                // jobs start from the configuration given in the batch's command line
+                T x;
+                Parser parser(x);
+                if(!config_.is_null()) parser.baseline(&config_);
+                if(parser.parse(line)) {
+                    std::vector<std::string> args(parser.args().begin(), parser.args().end());
+                    std::ostringstream output;
+                    result["config"] = x.config();
+
+                    {
+                        RunContextScope scope;
+                        current_run().args = &args;
+                        current_run().out = &output;
+                        Measurements measurements;
+                        result["return"] = run_recorded(x, measurements, true);
+                    }
+
+                    result["output"] = std::move(output).str();
+                } else {
+                    result["errors"] = parser.errors();
+                    result["return"] = -1;
+                }
+            } catch(std::exception const& e) {
+                // a failing job must not keep the jobs following it from being reported
+                result["errors"] = nlohmann::json::array({ std::string("job failed: ") + e.what() });
+                result["return"] = -1;
+            } catch(...) {
+                result["errors"] = nlohmann::json::array({ "job failed" });
+                result["return"] = -1;
+            }
+
+            std::lock_guard lock(mutex);
+            results[i % window] = std::move(result);
+            while(results[next_report % window]) {
+                auto& r = results[next_report % window];
+                if(return_code == 0) return_code = (*r)["return"].get<int>();
+                out << r->dump() << std::endl;
+                r.reset();
+                ++next_report;
+            }
+            reported.notify_all();
+        };
+
+        std::unique_ptr<ThreadPool> batch_pool;
+        if(parallel > 1) batch_pool = std::make_unique<ThreadPool>(parallel);
+
+        // read and submit jobs, skipping blank lines and comments
+        std::string line;
+        size_t line_number = 0;
+        size_t num_jobs = 0;
+        while(std::getline(in, line)) {
+            ++line_number;
+            auto const first = line.find_first_not_of(" \t\r");
+            if(first == std::string::npos || line[first] == '#') continue;
+
+            auto const i = num_jobs++;
+            if(batch_pool) {
+                {
+                    std::unique_lock lock(mutex);
+                    reported.wait(lock, [&]{ return i - next_report < window; });
+                }
+                batch_pool->submit([&, i, line_number, line = std::move(line)]{ run_job(i, line_number, line); });
+            } else {
+                run_job(i, line_number, line);
+            }
+        }
+        if(batch_pool) batch_pool->wait();
+        return return_code;
+    }
+
+    mutable std::unique_ptr<ThreadPool> pool_;
+    std::unique_ptr<std::mutex> pool_mutex_ = std::make_unique<std::mutex>(); // guards starting the pool
+    std::unique_ptr<Profiler> profiler_ = std::make_unique<Profiler>();
+    std::unique_ptr<ResultSink> result_sink_ = std::make_unique<ResultSink>();
+    std::unique_ptr<Measurements> measurements_ = std::make_unique<Measurements>(); // measurements not attributed to a specific run
+    std::unique_ptr<ControlServer> control_;
+
+    // the state of the run executing on the current thread
+    struct RunContext {
+        Measurements* measurements = nullptr;           // the measurements of the run, if any
+        std::vector<std::string> const* args = nullptr; // the free arguments of a batch job, if any
+        std::ostream* out = nullptr;                    // the captured output of a batch job, if any
+        EventLoop* loop = nullptr;                      // the event loop driving an asynchronous run, if any
+    };
+
+    inline static RunContext& current_run() {
+        thread_local RunContext current;
+        return current;
+    }
+
+    // restores the state of the run executing on the current thread when leaving a scope, also if an exception is thrown
+    class RunContextScope {
+    private:
+        RunContext saved_;
+
+    public:
+        inline RunContextScope() : saved_(current_run()) {
+        }
+
+        RunContextScope(RunContextScope const&) = delete;
+        RunContextScope& operator=(RunContextScope const&) = delete;
+
+        inline ~RunContextScope() { current_run() = saved_; }
+    };
+
+    // parses the command line and configures the given object, allocating temporary data from the given arena
+    inline bool parse(ConfigObject& x, int argc, char** argv, Arena& arena) {
+        // parse
+        {
+            if(argc > 0) {
+                binary_ = argv[0];
+            }
+
+            ErrorList errors(arena.resource());
+
+            // parse command line into json
+            auto cmdline = parse_cmdline(argc, argv, errors);
+            if(report_errors(errors)) return false;
+            // if constexpr(DEBUG) std::cout << "parsed config: " << cmdline.json << std::endl;
+
+            // configure the application itself
+            {
+                auto matched = match_config(*this, cmdline.json, cmdline.args, true, "", errors);
+                if(report_errors(errors)) return false;
+                configure(matched);
+                profiler_ = std::make_unique<Profiler>(options_.profile || !options_.trace.empty(), options_.perf);
+                result_sink_ = std::make_unique<ResultSink>(options_.result_format, options_.results);
+            }
+
+            // load a configuration file, if requested, as a layer below the command line
+            ConfigLayers layers;
+            if(!options_.config.empty()) {
+                nlohmann::json file_config;
+                if(!load_config_file(options_.config, file_config, errors)) {
+                    report_errors(errors);
+                    return false;
+                }
+
+                std::pmr::vector<char const*> no_args(errors.get_allocator());
+                auto matched = match_config(x, file_config, no_args, false, "", errors);
+                if(report_errors(errors)) return false;
+                layers.push("file " + options_.config, std::move(matched));
+
+                // select the alternatives chosen by the file, so that the command line is matched against them unless it selects others
+                x.configure(layers);
+            }
+
+            // extract the dimensions of a parameter sweep, if requested
+            if(options_.sweep) {
+                extract_sweep(x, cmdline.json, cmdline.args, {}, sweep_, errors);
+                if(report_errors(errors)) return false;
+            }
+            
+            // attempt to match the parsed configuration to the given object
+            auto matched = match_config(x, cmdline.json, cmdline.args, false, "", errors);
+
+            if(report_errors(errors)) return false;
+            assert(cmdline.json.empty()); // everything should have been matched
+
+            // configure the executable, recording the provenance of each parameter
+            layers.push("command line", std::move(matched));
+            x.configure(layers);
+
+            // the other run modes configure fresh objects from a single configuration
+            if(batching() || options_.tune > 0 || sweeping() || options_.repeat > 0) config_ = layers.merged();
+
+            // gather the remaining free arguments
+            for(auto const& arg : cmdline.args) {
+                if(arg) args_.emplace_back(arg);
+            }
+        }
+
+        if(help_) {
+            // print help
+            print_usage(x);
+            return false;
+        } else {
+            // apply the process-level setup
+            ErrorList errors(arena.resource());
+            options_.apply(errors);
+            return !report_errors(errors);
+        }
+    }
+
 
 public:
     /**
@@ -77,7 +644,13 @@ public:
      * testing whether the command line was successfully parsed and then running the actual program.
      * 
      * The config object is expected to have a function called \c run that accepts a reference to the application as a parameter
-     * and returns an integer return code.
+     * and returns an integer return code (see \ref Runnable ).
+     * 
+     * Alternatively, the config object may select an implementation via a \ref Choice or \ref Specialized value returned by a function called \c dispatch (see \ref Dispatchable ).
+     * In that case, \c run is called with the selected alternative as an additional parameter, so that it is instantiated for each alternative.
+     * If the object is both runnable and dispatchable, dispatch takes precedence.
+     * 
+     * Batch mode, autotuning, parameter sweeps and benchmarks (see \ref run(int,char**) ) run freshly constructed objects instead of the given one, which requires \c T to be default-constructible.
      * 
      * \tparam T the runnable config object type
      * \param x the runnable config object
@@ -86,18 +659,92 @@ public:
      * \return the return code
      */
     template<DerivedFromConfigObject T>
-    requires requires(T x, Application const& app) {
-        { x.run(app) } -> std::convertible_to<int>;
-    }
+    requires Runnable<T> || Dispatchable<T>
     inline static int run(T& x, int argc, char** argv) {
         Application app(x, argc, argv);
         if(app) {
-            return x.run(app);
+            int return_code;
+            if(app.batching() || app.options_.tune > 0 || app.sweeping() || app.options_.repeat > 0) {
+                if constexpr(std::default_initializable<T>) {
+                    if(app.batching()) {
+                        return_code = app.run_batch<T>();
+                    } else if(app.options_.tune > 0) {
+                        return_code = app.run_tune<T>();
+                    } else if(app.sweeping()) {
+                        return_code = app.run_sweep<T>();
+                    } else {
+                        auto const result = app.run_configured<T>(app.config_);
+                        std::cout << result.dump() << std::endl;
+                        return_code = result["return"].template get<int>();
+                    }
+                } else {
+                    std::cerr << "batch mode, autotuning, parameter sweeps and benchmarks require a default-constructible config object" << std::endl;
+                    return -1;
+                }
+            } else {
+                nlohmann::json defaults;
+                if constexpr(std::default_initializable<T>) {
+                    if(!app.options_.control.empty()) defaults = T().config();
+                }
+                if(!app.serve_control(x, std::move(defaults))) return -1;
+                return_code = app.run_recorded(x, *app.measurements_, true);
+            }
+
+            app.report_profile(app.sweeping() || app.batching() ? app.config_ : x.config());
+            return return_code;
         } else {
             return -1;
         }
     }
 
+    /**
+     * \brief Parses the command line and runs a config object of the specified type
+     * 
+     * This is equivalent to \ref run(T&,int,char**) using a default-constructed object.
+     * 
+     * If a parameter sweep is requested using <tt>--oocmd.sweep</tt> , single-valued parameters may be assigned multiple values,
+     * either by repeating the assignment or as a comma-separated list, e.g., <tt>--block=64,128,256 --threads=1,2,4</tt> .
+     * Comma-separated lists are not split for parameters that accept them as a single string value, such as strings or CPU sets; these can be swept over by repeating the assignment.
+     * A fresh object is then constructed, configured and run for each point of the cartesian product of all assigned values.
+     * Up to <tt>--oocmd.jobs</tt> runs are executed concurrently, unless combined with a benchmark.
+     * For each run, a JSON line containing the object's configuration and the return code is written to the file given by <tt>--oocmd.sweep_output</tt> , or to the standard output, in the order of the points.
+     * The return code of the sweep is that of the first run that returned a non-zero value, or zero if all runs succeeded.
+     * 
+     * If a benchmark is requested using <tt>--oocmd.repeat=N</tt> , each run is preceded by <tt>--oocmd.warmup</tt> unmeasured runs and then repeated \c N times,
+     * each time on a freshly configured object, stopping at the first non-zero return code.
+     * For each measured run, the wall-clock, user and system time, the maximum resident set size and the number of page faults are recorded (see \ref ResourceUsage ).
+     * These are reported along with their \ref Statistics "summary statistics" and the object's configuration as a JSON line on the standard output, or as part of the sweep output if combined with a sweep.
+     * Since the resource usage is measured for the whole process, a sweep combined with a benchmark executes its runs one at a time regardless of <tt>--oocmd.jobs</tt> .
+     * 
+     * If batch mode is requested using <tt>--oocmd.batch=FILE</tt> , each line of the job file (or the standard input if \c FILE is <tt>-</tt> ) is a shell-quoted command line for the object,
+     * which is parsed by a \ref Parser into a freshly constructed object that is then run; blank lines and lines starting with <tt>#</tt> are skipped.
+     * Job command lines configure the object starting from the configuration given in the application's command line (and configuration file),
+     * and do not accept standard options, which apply to the batch as a whole and take precedence over any other mode.
+     * A job that throws an exception is reported with its error and a non-zero return code.
+     * Up to <tt>--oocmd.parallel</tt> jobs are executed concurrently, and the job file is read only as fast as jobs complete.
+     * Within a job, \ref args reports the job's free arguments and anything written to \ref out is captured.
+     * For each job, a JSON line containing the job's index and line number, the object's configuration, the return code and the captured output (or the errors if the command line could not be parsed)
+     * is written to the file given by <tt>--oocmd.batch_output</tt> , or to the standard output, in the order of the job file.
+     * The return code of the batch is that of the first job that returned a non-zero value, or zero if all jobs succeeded.
+     * 
+     * If autotuning is requested using <tt>--oocmd.tune=N</tt> , the parameters marked \ref ConfigObject::tunable "tunable" that are not assigned explicitly are searched over
+     * using the strategy given by <tt>--oocmd.tune_strategy</tt> with at most \c N runs, each on a freshly configured object.
+     * The objective to minimize is the wall-clock time of a run, or the measurement given by <tt>--oocmd.tune_objective</tt> (see \ref record ).
+     * Each evaluation is logged as a JSON line on the standard error.
+     * The best configuration is written as JSON to <tt>--oocmd.tune_output</tt> , or the standard output, and can be loaded again using <tt>--oocmd.config</tt> .
+     * 
+     * \tparam T the runnable config object type
+     * \param argc the number of command-line arguments
+     * \param argv the command line arguments
+     * \return the return code
+     */
+    template<DerivedFromConfigObject T>
+    requires (Runnable<T> || Dispatchable<T>) && std::default_initializable<T>
+    inline static int run(int argc, char** argv) {
+        T x;
+        return run(x, argc, argv);
+    }
+
     /**
      * \brief Attempts to parse the given command line and configure the given object
      * 
@@ -112,51 +759,153 @@ public:
         // declare params
         {
             param('h', "help", help_, "Shows this help.");
+            param("oocmd", options_, "Standard options.");
         }
 
-        // parse
-        {
-            if(argc > 0) {
-                binary_ = argv[0];
-            }
+        // parse using a temporary arena
+        arena_ = std::make_unique<Arena>();
+        good_ = parse(x, argc, argv, *arena_);
 
-            std::vector<std::string> errors;
+        arena_stats_ = arena_->stats();
+        arena_.reset();
+        if(arena_hook()) arena_hook()(arena_stats_);
+    }
 
-            // parse command line into json
-            auto cmdline = parse_cmdline(argc, argv, errors);
-            if(report_errors(errors)) return;
-            // if constexpr(DEBUG) std::cout << "parsed config: " << cmdline.json << std::endl;
+    /**
+     * \brief Provides access to the application's thread pool
+     * 
+     * The pool is started on first access.
+     * Its size and the pinning of its workers are configured by the standard parameters <tt>--oocmd.threads</tt> , <tt>--oocmd.pin</tt> and <tt>--oocmd.placement</tt> (see \ref Options ).
+     * The pool is shut down when the application is destroyed, after all pending tasks have been completed.
+     * 
+     * \return the application's thread pool
+     */
+    inline ThreadPool& pool() const {
+        std::lock_guard lock(*pool_mutex_);
 
-            // configure the application itself
-            {
-                auto matched = match_config(*this, cmdline.json, cmdline.args, true, "", errors);
-                if(report_errors(errors)) return;
-                configure(matched);
-            }
-            
-            // attempt to match the parsed configuration to the given object
-            auto matched = match_config(x, cmdline.json, cmdline.args, false, "", errors);
+        if(!pool_) {
+            auto const threads = options_.threads ? options_.threads : machine::available_cores();
+            auto const pinning = options_.pin.empty() ? std::vector<unsigned>() : options_.pin.plan(threads, options_.placement);
+            pool_ = std::make_unique<ThreadPool>(threads, pinning);
+        }
+        return *pool_;
+    }
 
-            if(report_errors(errors)) return;
-            assert(cmdline.json.empty()); // everything should have been matched
+    /**
+     * \brief Provides access to the event loop driving the asynchronous run executing on the calling thread
+     * 
+     * If the \c run function of a config object is a coroutine returning a \ref Task , it is driven to completion on a fresh \ref EventLoop on the thread that would otherwise call it,
+     * so that its coroutines can wait for timers and file descriptors without requiring any further threads.
+     * This is also the case for each run of a parameter sweep, batch or benchmark.
+     * 
+     * This function must only be called from coroutines driven by that loop.
+     * 
+     * \return the event loop of the current run
+     */
+    inline EventLoop& loop() const {
+        auto* const loop = current_run().loop;
+        assert(loop);
+        return *loop;
+    }
 
-            // configure the executable
-            x.configure(matched);
+    /**
+     * \brief Starts serving the control socket requested using <tt>--oocmd.control=PATH</tt> for the given object
+     * 
+     * The socket is served until the application is destroyed; see \ref ControlServer for the supported commands.
+     * When run via \ref run , this is done for the configured object unless a batch, autotuning, parameter sweep or benchmark is run, in which case no socket is served.
+     * 
+     * \param x the object to control, which must outlive the application
+     * \param defaults the default configuration of the object, which is required in order to report differences from the defaults
+     * \return true if the socket is being served or none was requested
+     * \return false if the socket could not be served, in which case an error is printed to the standard error
+     */
+    inline bool serve_control(ConfigObject& x, nlohmann::json defaults = nlohmann::json()) {
+        if(options_.control.empty()) return true;
 
-            // gather the remaining free arguments
-            for(auto const& arg : cmdline.args) {
-                if(arg) args_.emplace_back(arg);
-            }
+        control_ = std::make_unique<ControlServer>(x, options_.control, std::move(defaults));
+        if(!control_->good()) {
+            std::cerr << control_->error() << std::endl;
+            control_.reset();
+            return false;
         }
+        return true;
+    }
 
-        if(help_) {
-            // print help
-            print_usage(x);
-        } else {
-            good_ = true;
-        }
+    /**
+     * \brief Provides access to the control socket served for the configured object
+     * 
+     * \return the control server, or \c nullptr if none is being served
+     */
+    inline ControlServer const* control() const { return control_.get(); }
+
+    /**
+     * \brief Tests whether a parameter sweep was requested and any parameter was assigned multiple values
+     * 
+     * \return true if a parameter sweep is to be run
+     * \return false otherwise
+     */
+    inline bool sweeping() const { return !sweep_.empty(); }
+
+    /**
+     * \brief Tests whether batch mode was requested, i.e., a job file was given
+     * 
+     * \return true if a batch of jobs is to be run
+     * \return false otherwise
+     */
+    inline bool batching() const { return !options_.batch.empty(); }
+
+    /**
+     * \brief Provides access to the application's phase profiler
+     * 
+     * The profiler is enabled by the standard parameters <tt>--oocmd.profile</tt> or <tt>--oocmd.trace</tt> , and hardware performance counters are recorded if <tt>--oocmd.perf</tt> is given (see \ref Options ).
+     * When run via \ref run , the aggregated phase tree is printed to the standard error and the trace, which embeds the configuration, is written after running.
+     * 
+     * \return the application's phase profiler
+     */
+    inline Profiler& profiler() const { return *profiler_; }
+
+    /**
+     * \brief Records a measurement for the current run
+     * 
+     * When run via \ref run , a result line is written after each run for which any measurements were recorded.
+     * The line contains every parameter of the resolved configuration followed by the measurements (see \ref ResultSink ).
+     * It is appended to the file given by <tt>--oocmd.results</tt> , or written to the standard output, in the format given by <tt>--oocmd.result_format</tt> .
+     * 
+     * During a parameter sweep, batch or benchmark, measurements are attributed to the run executing on the calling thread;
+     * measurements recorded on other threads, e.g., by tasks of the \ref pool "thread pool", are only attributed to a run if no sweep, batch or benchmark is running.
+     * 
+     * \param key the key of the measurement
+     * \param value the measured value, typically a number or a string
+     */
+    inline void record(std::string_view const key, nlohmann::json value) const {
+        auto* const current = current_run().measurements;
+        (current ? *current : *measurements_).record(key, std::move(value));
     }
 
+    /**
+     * \brief Sets a hook that is called with the arena statistics whenever an application has parsed a command line
+     * 
+     * Command line parsing and matching allocate temporary data from a monotonic arena owned by the application, which is released after parsing.
+     * The JSON representations of configurations are not allocated from the arena.
+     * 
+     * \param hook the hook, or an empty function to remove the hook
+     */
+    inline static void set_arena_hook(std::function<void(ArenaStats const&)> hook) { arena_hook() = std::move(hook); }
+
+    /**
+     * \brief Reports the memory allocated by the arena that was used to parse the command line
+     * 
+     * \return the arena statistics
+     */
+    inline ArenaStats const& arena_stats() const { return arena_stats_; }
+
+    /**
+     * \brief Provides access to the standard options
+     * 
+     * \return the standard options
+     */
+    inline Options const& options() const { return options_; }
+
     /**
      * \brief Equivalent to \ref good
      */
@@ -197,9 +946,26 @@ public:
      * Free arguments are those that did not represent values of any object parameters.
      * Typically, these are considered paths to input files.
      * 
+     * In batch mode, these are the free arguments of the job executing on the calling thread.
+     * 
      * \return the free arguments gathered from the command line
      */
-    inline std::vector<std::string> const& args() const { return args_; }
+    inline std::vector<std::string> const& args() const {
+        auto const* job = current_run().args;
+        return job ? *job : args_;
+    }
+
+    /**
+     * \brief Provides access to the stream that a run should write its output to
+     * 
+     * This is the standard output, except in batch mode, where the output of the job executing on the calling thread is captured and reported along with its return code.
+     * 
+     * \return the output stream of the current run
+     */
+    inline std::ostream& out() const {
+        auto* const job = current_run().out;
+        return job ? *job : std::cout;
+    }
 };
 
 }
@@ -0,0 +1,202 @@
+#ifndef _OOCMD_AUTOTUNER_HPP
+#define _OOCMD_AUTOTUNER_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <oocmd/util/enum_table.hpp>
+
+namespace oocmd {
+
+/**
+ * \brief Search strategies for autotuning
+ */
+enum class TuningStrategy {
+    random,     ///< evaluate random points of the search space
+    coordinate, ///< optimize one dimension at a time while keeping the others fixed, until no dimension improves
+    halving     ///< successive halving: evaluate random points, then repeatedly re-evaluate the better half with doubled effort
+};
+
+template<> struct enum_names<TuningStrategy> {
+    static constexpr auto table = make_enum_table<TuningStrategy>({
+        { "random", TuningStrategy::random }, { "coordinate", TuningStrategy::coordinate }, { "halving", TuningStrategy::halving } });
+};
+
+/**
+ * \brief Searches a discrete search space for the point minimizing an objective with a budget of evaluations
+ *
+ * The search space is the cartesian product of the dimensions, each of which is given by its number of values.
+ * A point is identified by the index of its value in each dimension.
+ */
+class Autotuner {
+public:
+    using Point = std::vector<size_t>;
+
+    /**
+     * \brief The objective function, which is to be minimized
+     *
+     * Failed evaluations should report infinity.
+     */
+    using Objective = std::function<double(Point const&)>;
+
+private:
+    std::vector<size_t> dims_;
+    TuningStrategy strategy_;
+    size_t budget_;
+    std::mt19937_64 rng_;
+
+    size_t evaluations_ = 0;
+    std::map<Point, std::vector<double>> results_; // the objective values measured for each evaluated point
+
+    Point random_point() {
+        Point p(dims_.size());
+        for(size_t d = 0; d < dims_.size(); d++) p[d] = std::uniform_int_distribution<size_t>(0, dims_[d] - 1)(rng_);
+        return p;
+    }
+
+    uint64_t space_size() const {
+        uint64_t n = 1;
+        for(auto const k : dims_) {
+            if(__builtin_mul_overflow(n, uint64_t(k), &n)) return UINT64_MAX;
+        }
+        return n;
+    }
+
+    bool exhausted() const { return evaluations_ >= budget_; }
+
+    // evaluates a point once more
+    double evaluate(Objective const& f, Point const& p) {
+        ++evaluations_;
+        auto const v = f(p);
+        results_[p].push_back(v);
+        return v;
+    }
+
+    // evaluates a point unless it has been evaluated before
+    double evaluate_once(Objective const& f, Point const& p) {
+        auto it = results_.find(p);
+        return (it != results_.end()) ? score(it->second) : evaluate(f, p);
+    }
+
+    // the score of a point is the median of its measured objective values
+    static double score(std::vector<double> values) {
+        if(values.empty()) return std::numeric_limits<double>::infinity();
+        auto mid = values.begin() + values.size() / 2;
+        std::nth_element(values.begin(), mid, values.end());
+        return *mid;
+    }
+
+    void search_random(Objective const& f) {
+        // avoid re-evaluating points as long as unevaluated points exist
+        auto const size = space_size();
+        while(!exhausted() && results_.size() < size) {
+            auto const p = random_point();
+            if(!results_.contains(p)) evaluate(f, p);
+        }
+    }
+
+    void search_coordinate(Objective const& f) {
+        // start in the middle of the space
+        Point best(dims_.size());
+        for(size_t d = 0; d < dims_.size(); d++) best[d] = dims_[d] / 2;
+        auto best_score = evaluate_once(f, best);
+
+        bool improved = true;
+        while(improved && !exhausted()) {
+            improved = false;
+            for(size_t d = 0; d < dims_.size() && !exhausted(); d++) {
+                auto p = best;
+                for(size_t i = 0; i < dims_[d] && !exhausted(); i++) {
+                    p[d] = i;
+                    auto const s = evaluate_once(f, p);
+                    if(s < best_score) {
+                        best_score = s;
+                        best = p;
+                        improved = true;
+                    }
+                }
+            }
+        }
+    }
+
+    void search_halving(Objective const& f) {
+        // choose the number of initial candidates such that each of the ~log2(n) rounds costs about n evaluations
+        size_t n = 2;
+        while((n + 1) * std::bit_width(n) <= budget_) ++n;
+        n = size_t(std::min(uint64_t(n), space_size()));
+
+        std::vector<Point> candidates;
+        for(size_t tries = 0; candidates.size() < n && tries < 16 * n; tries++) {
+            auto const p = random_point();
+            if(std::find(candidates.begin(), candidates.end(), p) == candidates.end()) candidates.push_back(p);
+        }
+
+        size_t reps = 1;
+        while(!exhausted() && !candidates.empty()) {
+            for(auto const& p : candidates) {
+                for(size_t r = results_[p].size(); r < reps && !exhausted(); r++) evaluate(f, p);
+            }
+            if(candidates.size() == 1) break;
+
+            std::stable_sort(candidates.begin(), candidates.end(), [&](Point const& a, Point const& b){ return score(results_[a]) < score(results_[b]); });
+            candidates.resize((candidates.size() + 1) / 2);
+            reps *= 2;
+        }
+    }
+
+public:
+    /**
+     * \brief Constructs an autotuner
+     *
+     * \param dims the number of values in each dimension, each of which must be positive
+     * \param strategy the search strategy
+     * \param budget the maximum number of objective evaluations
+     * \param seed the seed for random decisions
+     */
+    inline Autotuner(std::vector<size_t> dims, TuningStrategy const strategy, size_t const budget, uint64_t const seed = 0)
+        : dims_(std::move(dims)), strategy_(strategy), budget_(budget), rng_(seed) {
+    }
+
+    /**
+     * \brief Searches for the point minimizing the objective
+     *
+     * \param f the objective function
+     * \param out_best receives the best point found
+     * \return the score of the best point found, i.e., the median of its objective values, or infinity if no point was evaluated successfully
+     */
+    inline double tune(Objective const& f, Point& out_best) {
+        switch(strategy_) {
+            case TuningStrategy::random: search_random(f); break;
+            case TuningStrategy::coordinate: search_coordinate(f); break;
+            case TuningStrategy::halving: search_halving(f); break;
+        }
+
+        auto best_score = std::numeric_limits<double>::infinity();
+        out_best = Point(dims_.size(), 0);
+        for(auto const& [p, values] : results_) {
+            auto const s = score(values);
+            if(s < best_score) {
+                best_score = s;
+                out_best = p;
+            }
+        }
+        return best_score;
+    }
+
+    /**
+     * \brief Reports the number of objective evaluations performed so far
+     *
+     * \return the number of objective evaluations
+     */
+    inline size_t evaluations() const { return evaluations_; }
+};
+
+}
+
+#endif
@@ -0,0 +1,313 @@
+#ifndef _OOCMD_CHOICE_HPP
+#define _OOCMD_CHOICE_HPP
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <variant>
+
+#include <oocmd/config_object.hpp>
+
+namespace oocmd {
+
+// abstract base for parameters that select one of several config object types by type name
+class ChoiceParam : public ConfigParam {
+public:
+    static constexpr size_t NONE = SIZE_MAX;
+
+    using ConfigParam::ConfigParam;
+
+    /**
+     * \brief Reports the number of config object types that can be chosen from
+     *
+     * \return the number of choices
+     */
+    virtual size_t num_choices() const = 0;
+
+    /**
+     * \brief Constructs a default instance of the i-th config object type that can be chosen from
+     *
+     * This is used to match configurations and print usage information for a choice that is not currently selected.
+     *
+     * \param i the index of the choice
+     * \return a default instance of the i-th choice
+     */
+    virtual std::unique_ptr<ConfigObject> make_choice(size_t i) const = 0;
+
+    /**
+     * \brief Reports the type name of the i-th config object type that can be chosen from
+     *
+     * \param i the index of the choice
+     * \return the interned type name of the i-th choice
+     */
+    virtual std::string const& choice_type_name(size_t i) const = 0;
+
+    /**
+     * \brief Provides access to the currently selected object
+     *
+     * \param owner the object owning the parameter
+     * \return a reference to the currently selected object
+     */
+    virtual ConfigObject const& object(ConfigObject const& owner) const = 0;
+
+    /**
+     * \brief Provides access to the currently selected object
+     *
+     * \param owner the object owning the parameter
+     * \return a reference to the currently selected object
+     */
+    virtual ConfigObject& object(ConfigObject& owner) const = 0;
+
+    /**
+     * \brief Finds the config object type with the given type name
+     *
+     * \param owner the object owning the parameter
+     * \param type_name the type name
+     * \return the index of the matching choice, or \ref NONE if none of the choices has the given type name
+     */
+    inline size_t find_choice(ConfigObject const& owner, std::string_view const type_name) const {
+        if(object(owner).type_name() == type_name) return selected(owner);
+
+        for(size_t i = 0; i < num_choices(); i++) {
+            if(choice_type_name(i) == type_name) return i;
+        }
+        return NONE;
+    }
+
+    /**
+     * \brief Reports the index of the currently selected choice
+     *
+     * \param owner the object owning the parameter
+     * \return the index of the currently selected choice
+     */
+    virtual size_t selected(ConfigObject const& owner) const = 0;
+
+    inline bool is_flag() const override { return false; }
+    inline bool is_list() const override { return false; }
+
+    inline std::string value_type_str() const override {
+        std::string s = "one of ";
+        for(size_t i = 0; i < num_choices(); i++) {
+            if(i > 0) s.append(", ");
+            s.append(choice_type_name(i));
+        }
+        return s;
+    }
+};
+
+/**
+ * \brief A member object whose type is chosen from a list of config object types during configuration
+ *
+ * Choices allow an application to select an implementation, e.g., one of several algorithm variants, by its \ref ConfigObject::type_name "type name".
+ * The selected object is stored by value, so that it can be dispatched to monomorphic code using \ref visit rather than via virtual functions.
+ *
+ * In the command line, the type name is assigned to the choice parameter directly, and parameters of the selected object are addressed as usual.
+ * For example, given a choice parameter named \c table , the arguments <tt>--table=HashB --table.load=0.9</tt> select the alternative with type name \c HashB and configure its parameter \c load .
+ * If no type name is given, the currently selected alternative is configured.
+ *
+ * By default, the first alternative is selected.
+ *
+ * \tparam Ts the config object types to choose from
+ */
+template<DerivedFromConfigObject... Ts>
+class Choice {
+private:
+    static_assert(sizeof...(Ts) > 0, "a choice requires at least one alternative");
+    static_assert((std::default_initializable<Ts> && ...), "all alternatives of a choice must be default constructible");
+
+    using Variant = std::variant<Ts...>;
+
+    template<size_t... Is>
+    void select(size_t i, std::index_sequence<Is...>) {
+        using Emplace = void(*)(Variant&);
+        static constexpr Emplace emplacers[] = { [](Variant& v){ v.template emplace<Is>(); }... };
+        emplacers[i](selected_);
+    }
+
+    template<size_t... Is>
+    static std::unique_ptr<ConfigObject> make(size_t i, std::index_sequence<Is...>) {
+        using Make = std::unique_ptr<ConfigObject>(*)();
+        static constexpr Make makers[] = { []() -> std::unique_ptr<ConfigObject> { return std::make_unique<std::variant_alternative_t<Is, Variant>>(); }... };
+        return makers[i]();
+    }
+
+    // the interned type names of the alternatives, which are determined only once by constructing each alternative
+    static std::string const& type_name(size_t i) {
+        static auto const type_names = []{
+            std::array<std::string const*, sizeof...(Ts)> type_names;
+            for(size_t j = 0; j < sizeof...(Ts); j++) type_names[j] = &make(j, std::index_sequence_for<Ts...>())->type_name();
+            return type_names;
+        }();
+        return *type_names[i];
+    }
+
+    Variant selected_;
+
+public:
+    // the parameter type used to bind choices to config objects
+    class Param : public ChoiceParam {
+    private:
+        ptrdiff_t offset_; // the offset of the choice within the owning object
+        size_t default_index_;
+
+    public:
+        inline Param() : offset_(0), default_index_(0) {
+        }
+
+        inline Param(ConfigObject const& owner, const char short_name, std::string_view name, Choice& ref, std::string_view desc)
+            : ChoiceParam(short_name, name, desc), offset_(offset_of(owner, &ref)), default_index_(ref.index()) {
+        }
+
+        inline size_t num_choices() const override { return sizeof...(Ts); }
+        inline std::unique_ptr<ConfigObject> make_choice(size_t i) const override { return Choice::make(i, std::index_sequence_for<Ts...>()); }
+        inline std::string const& choice_type_name(size_t i) const override { return Choice::type_name(i); }
+        inline ConfigObject const& object(ConfigObject const& owner) const override { return member<Choice>(owner, offset_).object(); }
+        inline ConfigObject& object(ConfigObject& owner) const override { return member<Choice>(owner, offset_).object(); }
+        inline size_t selected(ConfigObject const& owner) const override { return member<Choice>(owner, offset_).index(); }
+
+        // assigning a type name selects the respective alternative
+        inline bool assign(ConfigObject& owner, std::string_view const value, bool) const override {
+            auto const i = find_choice(owner, value);
+            if(i == NONE) return false;
+
+            auto& choice = member<Choice>(owner, offset_);
+            if(i != choice.index()) choice.select(i);
+            return true;
+        }
+
+        inline void reset(ConfigObject& owner) const override {
+            auto& choice = member<Choice>(owner, offset_);
+            if(choice.index() != default_index_) {
+                choice.select(default_index_);
+            } else {
+                choice.object().reset();
+            }
+        }
+
+        inline bool has_default_value(ConfigObject const& owner) const override { return selected(owner) == default_index_; }
+        inline ptrdiff_t offset() const override { return offset_; }
+
+        inline bool configure(ConfigObject& owner, nlohmann::json const& json) const override {
+            auto& choice = member<Choice>(owner, offset_);
+            if(json.contains(name())) {
+                auto const& v = json[name()];
+                if(v.is_object()) {
+                    if(v.contains(TYPE_NAME_KEY)) {
+                        auto const& type_name = v[TYPE_NAME_KEY];
+                        if(!type_name.is_string()) return false;
+
+                        auto const i = find_choice(owner, type_name.get<std::string>());
+                        if(i == NONE) return false;
+                        if(i != choice.index()) choice.select(i);
+                    }
+
+                    choice.object().configure(v);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        inline void read_config(ConfigObject const& owner, nlohmann::json& dst) const override {
+            auto const& x = object(owner);
+            auto sub = x.config();
+            sub[TYPE_NAME_KEY] = x.type_name();
+            dst[name()] = sub;
+        }
+
+        inline std::string default_value_str() const override { return choice_type_name(default_index_); }
+    };
+
+    /**
+     * \brief Constructs a choice with the first alternative selected
+     */
+    inline Choice() {
+    }
+
+    /**
+     * \brief Selects the i-th alternative
+     *
+     * The currently selected object is destroyed and replaced by a default instance of the i-th alternative.
+     *
+     * \param i the index of the alternative to select
+     */
+    inline void select(size_t i) { select(i, std::index_sequence_for<Ts...>()); }
+
+    /**
+     * \brief Reports the index of the currently selected alternative
+     *
+     * \return the index of the currently selected alternative
+     */
+    inline size_t index() const { return selected_.index(); }
+
+    /**
+     * \brief Tests whether the given type is currently selected
+     *
+     * \tparam T the type to test
+     * \return true if T is currently selected
+     * \return false otherwise
+     */
+    template<typename T>
+    inline bool holds() const { return std::holds_alternative<T>(selected_); }
+
+    /**
+     * \brief Provides access to the selected object as the given type
+     *
+     * \tparam T the type, which must currently be selected
+     * \return a reference to the selected object
+     */
+    template<typename T>
+    inline T& get() { return std::get<T>(selected_); }
+
+    /**
+     * \brief Provides access to the selected object as the given type
+     *
+     * \tparam T the type, which must currently be selected
+     * \return a reference to the selected object
+     */
+    template<typename T>
+    inline T const& get() const { return std::get<T>(selected_); }
+
+    /**
+     * \brief Provides access to the selected object as a config object
+     *
+     * \return a reference to the selected object
+     */
+    inline ConfigObject& object() { return std::visit([](auto& x) -> ConfigObject& { return x; }, selected_); }
+
+    /**
+     * \brief Provides access to the selected object as a config object
+     *
+     * \return a reference to the selected object
+     */
+    inline ConfigObject const& object() const { return std::visit([](auto const& x) -> ConfigObject const& { return x; }, selected_); }
+
+    /**
+     * \brief Invokes the given function on the selected object
+     *
+     * The function is instantiated for each alternative, so that it can operate on the concrete type.
+     *
+     * \param f the function to invoke, which must accept a reference to any of the alternatives
+     * \return the result of the function
+     */
+    template<typename F>
+    inline decltype(auto) visit(F&& f) { return std::visit(std::forward<F>(f), selected_); }
+
+    /**
+     * \brief Invokes the given function on the selected object
+     *
+     * The function is instantiated for each alternative, so that it can operate on the concrete type.
+     *
+     * \param f the function to invoke, which must accept a const reference to any of the alternatives
+     * \return the result of the function
+     */
+    template<typename F>
+    inline decltype(auto) visit(F&& f) const { return std::visit(std::forward<F>(f), selected_); }
+};
+
+}
+
+#endif
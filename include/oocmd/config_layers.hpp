@@ -0,0 +1,86 @@
+#ifndef _OOCMD_CONFIG_LAYERS_HPP
+#define _OOCMD_CONFIG_LAYERS_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include <oocmd/util/config_file.hpp>
+#include <oocmd/util/intern.hpp>
+
+namespace oocmd {
+
+/**
+ * \brief A stack of configurations from different sources, e.g., configuration files, the environment and the command line
+ *
+ * Each layer is a configuration in the form matched for a \ref ConfigObject and is not modified after it has been pushed.
+ * Layers pushed later take precedence over those pushed before, i.e., a value is looked up top-down.
+ *
+ * Rather than merging the layers into a single configuration, objects are configured from the layers directly (see \ref ConfigObject::configure(ConfigLayers const&) ),
+ * which records the source that each parameter was configured from as its \ref ConfigObject::provenance "provenance".
+ * Doing so descends into all layers along with the object tree, so that each parameter is resolved by a single step per layer.
+ */
+class ConfigLayers {
+public:
+    /**
+     * \brief A single layer
+     */
+    struct Layer {
+        std::string const* source; ///< the interned name of the source, e.g., <tt>command line</tt>
+        nlohmann::json config;     ///< the configuration provided by the source
+    };
+
+private:
+    std::vector<Layer> layers_;
+
+public:
+    static constexpr size_t NONE = SIZE_MAX;
+
+    /**
+     * \brief Pushes a layer on top of the stack
+     *
+     * \param source the name of the source, e.g., <tt>file settings.json</tt>
+     * \param config the configuration provided by the source
+     * \return the index of the layer
+     */
+    inline size_t push(std::string_view const source, nlohmann::json config) {
+        layers_.push_back({ &intern(source), std::move(config) });
+        return layers_.size() - 1;
+    }
+
+    /**
+     * \brief Reports the number of layers
+     *
+     * \return the number of layers
+     */
+    inline size_t size() const { return layers_.size(); }
+
+    /**
+     * \brief Provides access to a layer
+     *
+     * \param i the index of the layer, where higher indices take precedence
+     * \return the layer
+     */
+    inline Layer const& layer(size_t const i) const { return layers_[i]; }
+
+    /**
+     * \brief Merges all layers into a single configuration
+     *
+     * This copies the configurations and is only meant for consumers that require a single configuration, e.g., parameter sweeps.
+     *
+     * \return the merged configuration
+     */
+    inline nlohmann::json merged() const {
+        nlohmann::json config;
+        for(auto const& l : layers_) merge_config(config, l.config);
+        return config;
+    }
+};
+
+}
+
+#endif
@@ -2,30 +2,58 @@
 #define _OOCMD_CONFIG_OBJECT_HPP
 
 #include <algorithm>
+#include <cassert>
+#include <cstddef>
 #include <iostream>
-#include <unordered_map>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <utility>
+#include <vector>
 
 #include <oocmd/concepts.hpp>
+#include <oocmd/config_layers.hpp>
+#include <oocmd/config_schema.hpp>
 #include <oocmd/params/bytes_param.hpp>
 #include <oocmd/params/double_param.hpp>
 #include <oocmd/params/flag_param.hpp>
 #include <oocmd/params/float_param.hpp>
 #include <oocmd/params/int_param.hpp>
+#include <oocmd/params/live_param.hpp>
 #include <oocmd/params/string_list_param.hpp>
 #include <oocmd/params/string_param.hpp>
+#include <oocmd/params/traits_param.hpp>
 #include <oocmd/params/uint_param.hpp>
+#include <oocmd/util/cpu_set.hpp>
+#include <oocmd/util/duration.hpp>
+#include <oocmd/util/intern.hpp>
+#include <oocmd/util/rate.hpp>
+#include <oocmd/util/tuning_domain.hpp>
 
 #include <nlohmann/json.hpp>
 
 namespace oocmd {
 
+template<DerivedFromConfigObject... Ts> class Choice;
+template<auto V0, decltype(V0)... Vs> class Specialized;
+template<DerivedFromConfigObject T> class Lazy;
+template<typename T> class ParamHandle;
+
 /**
  * \brief Abstract base for config objects
  * 
  * Config objects can be configured from the command line by an \ref Application.
  * 
  * The \ref configure "configuration" of an object is done based on the \em parameters it declares.
- * Parameters are typically bound to instance members of the class and should declared during construction using the protected \ref param methods.
+ * Parameters are bound to instance members of the class and must be declared during construction using the protected \ref param methods.
+ * The declared parameters form the object's \ref ConfigSchema "schema", which is built by the first instance of a type and shared by all further instances,
+ * which only bind it to their members by their offsets within the object.
+ * Consequently, the parameters declared by a type must not depend on the arguments passed to its constructor.
+ * Likewise, parameters must be bound to members of the object itself, i.e., its own members, members of its base classes or members of member objects held by value.
+ * Binding anything outside of the object, e.g., a global variable or a value owned via a pointer, is not supported; in debug builds, this is detected by an assertion once a further instance is constructed.
+ * The default value of a parameter is the value its member holds after construction, which \ref reset restores.
  * Object parameters allow the use of member objects in terms of a configuration.
  * A configuration is thus represented by a tree of parameter assignments, internally represented using JSON.
  * 
@@ -61,32 +89,149 @@ namespace oocmd {
  */
 class ConfigObject {
 private:
-    std::string type_name_;
-    std::string desc_;
-    std::unordered_map<std::string, std::unique_ptr<ConfigParam>> params_;
-    std::unordered_map<char, std::string> short_params_;
+    friend class ConfigParam;
+
+    // type names, descriptions and the parameter names used as keys are interned, so all instances of a type share them
+    std::string const* type_name_ = &intern("");
+    std::string const* desc_ = &intern("");
+
+    // the shared schema of the object's type, the schema being built if this is the first instance of its type, or the schema of the type's base that was most recently declared during construction
+    mutable ConfigSchema const* schema_ = nullptr;
+    mutable ConfigSchema* building_ = nullptr;
+    std::shared_ptr<ConfigSchema const> owned_; // the schema if it is private, i.e., was built while the type's first instance was being constructed on another thread
+
+    // the default values of parameters whose members were initialized differently than those of the first instance, which are only allocated if there are any
+    std::unique_ptr<nlohmann::json> defaults_;
+
+    // per-instance annotations of parameters, which are only allocated if any parameter is annotated
+    std::unique_ptr<std::vector<std::pair<ConfigParam const*, std::string>>> annotations_;
+
+    // the interned names of the sources that parameters were configured from by a layered configuration, which are only allocated if any parameter was configured that way
+    using ProvenanceList = std::vector<std::pair<ConfigParam const*, std::string const*>>;
+    std::unique_ptr<ProvenanceList> provenance_;
+
+    // records the source that a parameter was configured from, or forgets it if no source is given
+    void set_provenance(ConfigParam const& param, std::string const* source) {
+        if(!provenance_) {
+            if(!source) return;
+            provenance_ = std::make_unique<ProvenanceList>();
+        }
+
+        for(auto it = provenance_->begin(); it != provenance_->end(); ++it) {
+            if(it->first == &param) {
+                if(source) {
+                    it->second = source;
+                } else {
+                    provenance_->erase(it);
+                }
+                return;
+            }
+        }
+        if(source) provenance_->emplace_back(&param, source);
+    }
+
+    // configures the object from the nodes of all layers at the object's path, ordered by precedence, where layers that do not configure the object have no node
+    // this is defined along with provenance_config
+    void configure_layered(ConfigLayers const& layers, std::span<nlohmann::json const* const> nodes);
+
+    // completes the schema being built, if any, which happens once the object has been constructed
+    void complete() const {
+        if(building_) {
+            ConfigSchema::conclude(*building_, false);
+            building_ = nullptr;
+        }
+    }
+
+    // determines the schema that parameters declared by the type currently being constructed are added to
+    // if the type's schema has already been built, it is adopted and nullptr is returned, i.e., the declaration is skipped
+    ConfigSchema* declaring() {
+        auto const& type = typeid(*this);
+        if(schema_ && schema_->type() == type) return building_;
+
+        // a further derived type starts declaring parameters, so the base type has been constructed
+        complete();
+        auto declaration = ConfigSchema::declare(type, schema_, std::move(owned_));
+        if(declaration.adopted) {
+            schema_ = declaration.adopted;
+        } else {
+            schema_ = building_ = declaration.building;
+            owned_ = std::move(declaration.owner);
+        }
+        return building_;
+    }
+
+    // the position in the adopted schema of the parameter declared next, which is expected to be declared in the same order as by the first instance
+    struct Adoption {
+        ConfigObject const* object = nullptr;
+        ConfigSchema const* schema = nullptr;
+        size_t next = 0;
+    };
+
+    static Adoption& adoption() {
+        thread_local Adoption adoption;
+        return adoption;
+    }
+
+    // binds a parameter of the adopted schema, keeping the member's initial value as its default value if it differs from that of the first instance
+    void adopt_param(std::string_view const name, void const* ref) {
+        auto const& params = schema_->own_params();
+        auto& cursor = adoption();
+        if(cursor.object != this || cursor.schema != schema_) cursor = { this, schema_, 0 };
+
+        ConfigParam const* param = nullptr;
+        if(cursor.next < params.size() && params[cursor.next]->name() == name) {
+            param = params[cursor.next].get();
+            ++cursor.next;
+        } else {
+            // the cursor was lost, e.g., because another object was constructed between two declarations
+            for(size_t i = 0; i < params.size(); i++) {
+                if(params[i]->name() == name) {
+                    param = params[i].get();
+                    cursor.next = i + 1;
+                    break;
+                }
+            }
+        }
+
+        assert(param); // the parameter was not declared by the first instance
+        bool const bound = param && param->offset() == reinterpret_cast<char const*>(ref) - reinterpret_cast<char const*>(this);
+        assert(bound); // the parameter is bound to something outside of the object
+        if(bound && !param->has_default_value(*this)) {
+            if(!defaults_) defaults_ = std::make_unique<nlohmann::json>(nlohmann::json::object());
+            param->read_config(*this, *defaults_);
+        }
+    }
 
     template<typename T, typename V>
-    void make_param(const char short_name, std::string&& name, V& ref, std::string&& desc) {
-        auto name_copy = std::string(name);
-        auto p = std::make_unique<T>(short_name, std::move(name), ref, std::move(desc));
-        if(p->has_short_name()) short_params_.emplace(short_name, name_copy);
-        params_.emplace(name_copy, std::move(p));
+    void make_param(const char short_name, std::string_view name, V& ref, std::string_view desc) {
+        if(auto* schema = declaring()) {
+            schema->add(std::make_unique<T>(*this, short_name, name, ref, desc));
+        } else {
+            adopt_param(name, &ref);
+        }
     }
 
 public:
     class NestedParam : public ConfigParam {
     private:
-        ConfigObject* object_;
+        ptrdiff_t          offset_;    // the offset of the targeted object within the owning object
+        std::string const* type_name_; // the type name of the targeted object
 
     public:
-        inline NestedParam() {
+        inline NestedParam() : offset_(0), type_name_(&intern("")) {
+        }
+
+        inline NestedParam(ConfigObject const& owner, const char short_name, std::string_view name, ConfigObject& x, std::string_view desc)
+            : ConfigParam(short_name, name, desc), offset_(offset_of(owner, &x)), type_name_(x.type_name_) {
         }
 
-        inline NestedParam(const char short_name, std::string&& name, ConfigObject& x, std::string&& desc)
-            : ConfigParam(short_name, std::move(name), std::move(desc)), object_(&x) {
+    protected:
+        // constructs a parameter whose targeted object is provided by a subclass
+        inline NestedParam(const char short_name, std::string_view name, std::string_view desc)
+            : ConfigParam(short_name, name, desc), offset_(0), type_name_(&intern("")) {
         }
 
+    public:
         NestedParam(NestedParam const&) = delete;
         NestedParam& operator=(NestedParam const&) = delete;
         NestedParam(NestedParam&&) = default;
@@ -95,20 +240,38 @@ public:
         /**
          * \brief Provides access to the targeted object
          * 
+         * \param owner the object owning the parameter
+         * \return a reference to the targeted object
+         */
+        inline virtual ConfigObject const& object(ConfigObject const& owner) const { return member<ConfigObject>(owner, offset_); }
+
+        /**
+         * \brief Provides access to the targeted object
+         * 
+         * \param owner the object owning the parameter
          * \return a reference to the targeted object
          */
-        inline ConfigObject const& object() const { return *object_; }
+        inline virtual ConfigObject& object(ConfigObject& owner) const { return member<ConfigObject>(owner, offset_); }
+
+        /**
+         * \brief Tests whether the targeted object exists, i.e., whether accessing it via \ref object does not construct it
+         * 
+         * \param owner the object owning the parameter
+         * \return true if the targeted object exists
+         * \return false if it would be constructed on access
+         */
+        inline virtual bool constructed(ConfigObject const& owner) const { (void)owner; return true; }
 
         inline bool is_flag() const override { return false; }
         inline bool is_list() const override { return false; }
 
-        inline bool configure(nlohmann::json const& json) const override {
-            if(json.contains(name_)) {
-                auto const& v = json[name_];
+        inline bool configure(ConfigObject& owner, nlohmann::json const& json) const override {
+            if(json.contains(name())) {
+                auto const& v = json[name()];
                 if(v.is_object() && !v.empty()) {
                     // don't try to configure using anything but a non-empty JSON object
                     // if it's not an object, that's fine, it may have been just a type name indicating what object to use
-                    object_->configure(v);
+                    object(owner).configure(v);
                 }
                 return true;
             } else {
@@ -116,15 +279,21 @@ public:
             }
         }
 
-        inline void read_config(nlohmann::json& dst) const override {
-            auto sub = object_->config();
+        inline void read_config(ConfigObject const& owner, nlohmann::json& dst) const override {
+            auto sub = object(owner).config();
             if(!sub.is_null()) {
-                dst[name_] = sub;
+                dst[name()] = sub;
             }
         }
 
+        // objects cannot be assigned a value other than their type name
+        inline bool assign(ConfigObject&, std::string_view const value, bool) const override { return value == *type_name_; }
+
+        inline void reset(ConfigObject& owner) const override { object(owner).reset(); }
+        inline ptrdiff_t offset() const override { return offset_; }
+
         inline std::string value_type_str() const override { return "object"; }
-        inline std::string default_value_str() const override { return std::string(object_->type_name()); }
+        inline std::string default_value_str() const override { return *type_name_; }
     };
 
 protected:
@@ -134,7 +303,7 @@ protected:
      * \param type_name the type display name used for error reporting and help output
      * \param desc a descriptive help text for users
      */
-    inline ConfigObject(std::string&& type_name, std::string&& desc) : type_name_(std::move(type_name)), desc_(std::move(desc)) {
+    inline ConfigObject(std::string_view type_name, std::string_view desc) : type_name_(&intern(type_name)), desc_(&intern(desc)) {
     }
 
     /**
@@ -148,7 +317,7 @@ protected:
      * \param ref  a reference to the variable bound to the parameter
      * \param desc an optional descriptive help text for users
      */
-    inline void param(const char short_name, std::string&& name, bool& ref, std::string&& desc = "") { make_param<FlagParam>(short_name, std::move(name), ref, std::move(desc)); }
+    inline void param(const char short_name, std::string_view name, bool& ref, std::string_view desc = "") { make_param<FlagParam>(short_name, name, ref, desc); }
 
     /**
      * \brief Declares a boolean config parameter, also known as a flag
@@ -160,7 +329,7 @@ protected:
      * \param ref  a reference to the variable bound to the parameter
      * \param desc an optional descriptive help text for users
      */
-    inline void param(std::string&& name, bool& ref, std::string&& desc = "") { param(0, std::move(name), ref, std::move(desc)); }
+    inline void param(std::string_view name, bool& ref, std::string_view desc = "") { param(0, name, ref, desc); }
 
     /**
      * \brief Declares a (signed) integer config parameter
@@ -172,7 +341,7 @@ protected:
      * \param ref  a reference to the variable bound to the parameter
      * \param desc an optional descriptive help text for users
      */
-    inline void param(const char short_name, std::string&& name, int& ref, std::string&& desc = "") { make_param<IntParam>(short_name, std::move(name), ref, std::move(desc)); }
+    inline void param(const char short_name, std::string_view name, int& ref, std::string_view desc = "") { make_param<IntParam>(short_name, name, ref, desc); }
    
     /**
      * \brief Declares a (signed) integer config parameter
@@ -183,7 +352,7 @@ protected:
      * \param ref  a reference to the variable bound to the parameter
      * \param desc an optional descriptive help text for users
      */
-    inline void param(std::string&& name, int& ref, std::string&& desc = "") { param(0, std::move(name), ref, std::move(desc)); }
+    inline void param(std::string_view name, int& ref, std::string_view desc = "") { param(0, name, ref, desc); }
 
     /**
      * \brief Declares an unsigned integer config parameter
@@ -193,7 +362,7 @@ protected:
      * \param ref  a reference to the variable bound to the parameter
      * \param desc an optional descriptive help text for users
      */
-    inline void param(const char short_name, std::string&& name, unsigned int& ref, std::string&& desc = "") { make_param<UIntParam>(short_name, std::move(name), ref, std::move(desc)); }
+    inline void param(const char short_name, std::string_view name, unsigned int& ref, std::string_view desc = "") { make_param<UIntParam>(short_name, name, ref, desc); }
 
     /**
      * \brief Declares an unsigned integer config parameter
@@ -202,7 +371,7 @@ protected:
      * \param ref  a reference to the variable bound to the parameter
      * \param desc an optional descriptive help text for users
      */
-    inline void param(std::string&& name, unsigned int& ref, std::string&& desc = "") { param(0, std::move(name), ref, std::move(desc)); }
+    inline void param(std::string_view name, unsigned int& ref, std::string_view desc = "") { param(0, name, ref, desc); }
 
     /**
      * \brief Declares an 64-bit unsigned integer config parameter
@@ -216,7 +385,7 @@ protected:
      * \param ref  a reference to the variable bound to the parameter
      * \param desc an optional descriptive help text for users
      */
-    inline void param(const char short_name, std::string&& name, uint64_t& ref, std::string&& desc = "") { make_param<BytesParam>(short_name, std::move(name), ref, std::move(desc)); }
+    inline void param(const char short_name, std::string_view name, uint64_t& ref, std::string_view desc = "") { make_param<BytesParam>(short_name, name, ref, desc); }
    
     /**
      * \brief Declares an 64-bit unsigned integer config parameter
@@ -229,7 +398,7 @@ protected:
      * \param ref  a reference to the variable bound to the parameter
      * \param desc an optional descriptive help text for users
      */
-    inline void param(std::string&& name, uint64_t& ref, std::string&& desc = "") { param(0, std::move(name), ref, std::move(desc)); }
+    inline void param(std::string_view name, uint64_t& ref, std::string_view desc = "") { param(0, name, ref, desc); }
 
     /**
      * \brief Declares a single-precision floating point config parameter
@@ -241,7 +410,7 @@ protected:
      * \param ref  a reference to the variable bound to the parameter
      * \param desc an optional descriptive help text for users
      */
-    inline void param(const char short_name, std::string&& name, float& ref, std::string&& desc = "") { make_param<FloatParam>(short_name, std::move(name), ref, std::move(desc)); }
+    inline void param(const char short_name, std::string_view name, float& ref, std::string_view desc = "") { make_param<FloatParam>(short_name, name, ref, desc); }
 
     /**
      * \brief Declares a single-precision floating point config parameter
@@ -252,7 +421,7 @@ protected:
      * \param ref  a reference to the variable bound to the parameter
      * \param desc an optional descriptive help text for users
      */
-    inline void param(std::string&& name, float& ref, std::string&& desc = "") { param(0, std::move(name), ref, std::move(desc)); }
+    inline void param(std::string_view name, float& ref, std::string_view desc = "") { param(0, name, ref, desc); }
 
     /**
      * \brief Declares a double-precision floating point config parameter
@@ -264,7 +433,7 @@ protected:
      * \param ref  a reference to the variable bound to the parameter
      * \param desc an optional descriptive help text for users
      */
-    inline void param(const char short_name, std::string&& name, double& ref, std::string&& desc = "") { make_param<DoubleParam>(short_name, std::move(name), ref, std::move(desc)); }
+    inline void param(const char short_name, std::string_view name, double& ref, std::string_view desc = "") { make_param<DoubleParam>(short_name, name, ref, desc); }
 
     /**
      * \brief Declares a double-precision floating point config parameter
@@ -275,7 +444,7 @@ protected:
      * \param ref  a reference to the variable bound to the parameter
      * \param desc an optional descriptive help text for users
      */
-    inline void param(std::string&& name, double& ref, std::string&& desc = "") { param(0, std::move(name), ref, std::move(desc)); }
+    inline void param(std::string_view name, double& ref, std::string_view desc = "") { param(0, name, ref, desc); }
 
     /**
      * \brief Declares a string config parameter
@@ -285,7 +454,7 @@ protected:
      * \param ref  a reference to the variable bound to the parameter
      * \param desc an optional descriptive help text for users
      */
-    inline void param(const char short_name, std::string&& name, std::string& ref, std::string&& desc = "") { make_param<StringParam>(short_name, std::move(name), ref, std::move(desc)); }
+    inline void param(const char short_name, std::string_view name, std::string& ref, std::string_view desc = "") { make_param<StringParam>(short_name, name, ref, desc); }
 
     /**
      * \brief Declares a string config parameter
@@ -294,7 +463,7 @@ protected:
      * \param ref  a reference to the variable bound to the parameter
      * \param desc an optional descriptive help text for users
      */
-    inline void param(std::string&& name, std::string& ref, std::string&& desc = "") { param(0, std::move(name), ref, std::move(desc)); }
+    inline void param(std::string_view name, std::string& ref, std::string_view desc = "") { param(0, name, ref, desc); }
 
     /**
      * \brief Declares a string list config parameter
@@ -306,7 +475,7 @@ protected:
      * \param ref  a reference to the variable bound to the parameter
      * \param desc an optional descriptive help text for users
      */
-    inline void param(const char short_name, std::string&& name, std::vector<std::string>& ref, std::string&& desc = "") { make_param<StringListParam>(short_name, std::move(name), ref, std::move(desc)); }
+    inline void param(const char short_name, std::string_view name, std::vector<std::string>& ref, std::string_view desc = "") { make_param<StringListParam>(short_name, name, ref, desc); }
 
     /**
      * \brief Declares a string list config parameter
@@ -317,7 +486,92 @@ protected:
      * \param ref  a reference to the variable bound to the parameter
      * \param desc an optional descriptive help text for users
      */
-    inline void param(std::string&& name, std::vector<std::string>& ref, std::string&& desc = "") { param(0, std::move(name), ref, std::move(desc)); }
+    inline void param(std::string_view name, std::vector<std::string>& ref, std::string_view desc = "") { param(0, name, ref, desc); }
+
+    /**
+     * \brief Declares a config parameter of any type with \ref value_traits
+     * 
+     * Values are parsed and formatted using the type's \ref value_traits specialization.
+     * This includes integers of any width, e.g., \c int64_t or \c uint8_t , as well as enumerations with an \ref enum_names specialization.
+     * 
+     * \tparam T the value type
+     * \param short_name the short (single-character) name of the parameter
+     * \param name the name of the parameter
+     * \param ref  a reference to the variable bound to the parameter
+     * \param desc an optional descriptive help text for users
+     */
+    template<HasValueTraits T>
+    void param(const char short_name, std::string_view name, T& ref, std::string_view desc = "") { make_param<TraitsParam<T>>(short_name, name, ref, desc); }
+
+    /**
+     * \brief Declares a config parameter of any type with \ref value_traits
+     * 
+     * Values are parsed and formatted using the type's \ref value_traits specialization.
+     * This includes integers of any width, e.g., \c int64_t or \c uint8_t , as well as enumerations with an \ref enum_names specialization.
+     * 
+     * \tparam T the value type
+     * \param name the name of the parameter
+     * \param ref  a reference to the variable bound to the parameter
+     * \param desc an optional descriptive help text for users
+     */
+    template<HasValueTraits T>
+    void param(std::string_view name, T& ref, std::string_view desc = "") { param(0, name, ref, desc); }
+
+    /**
+     * \brief Declares a live config parameter
+     * 
+     * Live parameters are bound to atomic variables, so that they may be assigned while the program is running, e.g., via the control socket of an \ref Application ,
+     * while other threads read them using relaxed loads.
+     * Values are parsed and formatted like those of flags, floating-point numbers or types with \ref value_traits , respectively.
+     * 
+     * \tparam T the value type
+     * \param short_name the short (single-character) name of the parameter
+     * \param name the name of the parameter
+     * \param ref  a reference to the atomic variable bound to the parameter
+     * \param desc an optional descriptive help text for users
+     */
+    template<LiveValue T>
+    void param(const char short_name, std::string_view name, std::atomic<T>& ref, std::string_view desc = "") { make_param<LiveParam<T>>(short_name, name, ref, desc); }
+
+    /**
+     * \brief Declares a live config parameter
+     * 
+     * Live parameters are bound to atomic variables, so that they may be assigned while the program is running, e.g., via the control socket of an \ref Application ,
+     * while other threads read them using relaxed loads.
+     * Values are parsed and formatted like those of flags, floating-point numbers or types with \ref value_traits , respectively.
+     * 
+     * \tparam T the value type
+     * \param name the name of the parameter
+     * \param ref  a reference to the atomic variable bound to the parameter
+     * \param desc an optional descriptive help text for users
+     */
+    template<LiveValue T>
+    void param(std::string_view name, std::atomic<T>& ref, std::string_view desc = "") { param(0, name, ref, desc); }
+
+    /**
+     * \brief Declares a specialized integer config parameter
+     * 
+     * The parameter is configured like an integer parameter; see \ref Specialized for details.
+     * 
+     * \param short_name the short (single-character) name of the parameter
+     * \param name the name of the parameter
+     * \param ref  a reference to the variable bound to the parameter
+     * \param desc an optional descriptive help text for users
+     */
+    template<auto V0, decltype(V0)... Vs>
+    void param(const char short_name, std::string_view name, Specialized<V0, Vs...>& ref, std::string_view desc = "") { make_param<typename Specialized<V0, Vs...>::Param>(short_name, name, ref, desc); }
+
+    /**
+     * \brief Declares a specialized integer config parameter
+     * 
+     * The parameter is configured like an integer parameter; see \ref Specialized for details.
+     * 
+     * \param name the name of the parameter
+     * \param ref  a reference to the variable bound to the parameter
+     * \param desc an optional descriptive help text for users
+     */
+    template<auto V0, decltype(V0)... Vs>
+    void param(std::string_view name, Specialized<V0, Vs...>& ref, std::string_view desc = "") { param(0, name, ref, desc); }
 
     /**
       * \brief Declares an object config parameter
@@ -331,23 +585,136 @@ protected:
       * \param desc an optional descriptive help text for users
       */
     template<DerivedFromConfigObject T>
-    void param(std::string&& name, T& ref, std::string&& desc = "") { make_param<NestedParam>(0, std::move(name), dynamic_cast<ConfigObject&>(ref), std::move(desc)); }
+    void param(std::string_view name, T& ref, std::string_view desc = "") { make_param<NestedParam>(0, name, dynamic_cast<ConfigObject&>(ref), desc); }
+
+    /**
+      * \brief Declares a lazily constructed object config parameter
+      * 
+      * The object is configured like an object parameter, but it is only constructed when it is first configured or accessed; see \ref Lazy for details.
+      * Note that object parameters cannot have a short name.
+      * 
+      * \tparam T the object type
+      * \param name the name of the parameter
+      * \param ref  a reference to the variable bound to the parameter
+      * \param desc an optional descriptive help text for users
+      */
+    template<DerivedFromConfigObject T>
+    void param(std::string_view name, Lazy<T>& ref, std::string_view desc = "") { make_param<typename Lazy<T>::Param>(0, name, ref, desc); }
+
+    /**
+      * \brief Declares a choice config parameter
+      * 
+      * The type name assigned to the parameter selects which of the alternatives is used, which is then configured recursively; see \ref Choice for details.
+      * Note that choice parameters cannot have a short name.
+      * 
+      * \tparam Ts the alternatives
+      * \param name the name of the parameter
+      * \param ref  a reference to the variable bound to the parameter
+      * \param desc an optional descriptive help text for users
+      */
+    template<DerivedFromConfigObject... Ts>
+    void param(std::string_view name, Choice<Ts...>& ref, std::string_view desc = "") { make_param<typename Choice<Ts...>::Param>(0, name, ref, desc); }
+
+    /**
+     * \brief Marks a config parameter as tunable
+     * 
+     * Tunable parameters are searched over by the autotuning mode of an \ref Application unless they are assigned explicitly.
+     * 
+     * \param name the name of the parameter, which must have been declared before
+     * \param domain the values to search over
+     */
+    inline void tunable(std::string const& name, TuningDomain domain) {
+        if(auto* schema = declaring()) {
+            assert(schema->get(name));
+            schema->add_tunable(name, std::move(domain));
+        }
+    }
 
 public:
     /**
      * \brief Constructs an empty object
      * 
      * Note that an object constructed in this way cannot be properly registered by an \ref Application as it is missing a type name.
-     * Consider using the \ref ConfigObject(std::string&&,std::string&&) constructor instead.
+     * Consider using the \ref ConfigObject(std::string_view,std::string_view) constructor instead.
      */
     inline ConfigObject() {
     }
 
-    ConfigObject(ConfigObject const&) = delete;
-    ConfigObject& operator=(ConfigObject const&) = delete;
+    /**
+     * \brief Copies an object
+     * 
+     * The copy shares the schema of the original, so its parameters are bound to the copied members.
+     * 
+     * \param other the object to copy
+     */
+    inline ConfigObject(ConfigObject const& other) : type_name_(other.type_name_), desc_(other.desc_), owned_(other.owned_) {
+        other.complete();
+        schema_ = other.schema_;
+        if(other.defaults_) defaults_ = std::make_unique<nlohmann::json>(*other.defaults_);
+        if(other.annotations_) annotations_ = std::make_unique<std::vector<std::pair<ConfigParam const*, std::string>>>(*other.annotations_);
+        if(other.provenance_) provenance_ = std::make_unique<ProvenanceList>(*other.provenance_);
+    }
+
+    inline ConfigObject& operator=(ConfigObject const& other) {
+        if(this != &other) {
+            complete();
+            other.complete();
+            type_name_ = other.type_name_;
+            desc_ = other.desc_;
+            schema_ = other.schema_;
+            owned_ = other.owned_;
+            defaults_ = other.defaults_ ? std::make_unique<nlohmann::json>(*other.defaults_) : nullptr;
+            annotations_ = other.annotations_ ? std::make_unique<std::vector<std::pair<ConfigParam const*, std::string>>>(*other.annotations_) : nullptr;
+            provenance_ = other.provenance_ ? std::make_unique<ProvenanceList>(*other.provenance_) : nullptr;
+        }
+        return *this;
+    }
+
+    /**
+     * \brief Moves an object
+     * 
+     * Parameters are bound to members by their offsets within the object, so the moved object remains configurable.
+     * Moving does not throw, so that containers such as \c std::vector relocate objects by moving them.
+     * 
+     * \param other the object to move
+     */
+    inline ConfigObject(ConfigObject&& other) noexcept
+        : type_name_(other.type_name_), desc_(other.desc_), owned_(other.owned_), defaults_(std::move(other.defaults_)), annotations_(std::move(other.annotations_)),
+          provenance_(std::move(other.provenance_)) {
+        // the moved-from object keeps sharing the schema, so that it remains usable
+        other.complete();
+        schema_ = other.schema_;
+    }
+
+    inline ConfigObject& operator=(ConfigObject&& other) {
+        if(this != &other) {
+            complete();
+            other.complete();
+            type_name_ = other.type_name_;
+            desc_ = other.desc_;
+            schema_ = other.schema_;
+            owned_ = other.owned_;
+            defaults_ = std::move(other.defaults_);
+            annotations_ = std::move(other.annotations_);
+            provenance_ = std::move(other.provenance_);
+        }
+        return *this;
+    }
 
-    ConfigObject(ConfigObject&&) = default;
-    ConfigObject& operator=(ConfigObject&&) = default;
+    inline virtual ~ConfigObject() {
+        // if the object is destroyed because its construction failed, the incomplete schema it was building is discarded
+        if(building_) ConfigSchema::conclude(*building_, true);
+    }
+
+    /**
+     * \brief Provides access to the schema of the object's type, i.e., the declared parameters shared by all instances
+     *
+     * \return the object's schema
+     */
+    inline ConfigSchema const& schema() const {
+        complete();
+        return schema_ ? *schema_ : ConfigSchema::empty();
+    }
 
     /**
      * \brief Attempts to retrieve a config parameter by name
@@ -355,13 +722,8 @@ public:
      * \param name the name of the parameter
      * \return a const pointer to the parameter with the given name, or \c nullptr if no such parameter exists
      */
-    inline ConfigParam const* get_param(std::string const& name) const {
-        auto it = params_.find(name);
-        if(it != params_.end()) {
-            return it->second.get();
-        } else {
-            return nullptr;
-        }
+    inline ConfigParam const* get_param(std::string_view const name) const {
+        return schema().get(name);
     }
 
     /**
@@ -371,14 +733,28 @@ public:
      * \return a const pointer to the parameter with the given short name, or \c nullptr if no such parameter exists
      */
     inline ConfigParam const* get_param(char const short_name) const {
-        auto it = short_params_.find(short_name);
-        if(it != short_params_.end()) {
-            return params_.find(it->second)->second.get(); // no need for an additional check; long name must exist
-        } else {
-            return nullptr;
-        }
+        return schema().get(short_name);
     }
 
+    /**
+     * \brief Resolves a typed handle to the value of a parameter by its dot-separated path
+     *
+     * The path is resolved once, descending into nested objects and the selected alternatives of choices and constructing \ref Lazy objects as needed.
+     * Reading the value via the handle is then a plain memory access.
+     * The handle refers to the value in this object and becomes invalid when the object is moved or destroyed, or when a choice along the path selects another alternative.
+     *
+     * The type must match the type of the variable bound to the parameter exactly, e.g., <tt>std::atomic<unsigned int></tt> for a live parameter,
+     * or be the type of a nested object or selected alternative.
+     * This is defined along with \ref ParamHandle .
+     *
+     * \tparam T the type of the value
+     * \param path the path of the parameter, e.g., <tt>cache.shards</tt>
+     * \param error receives a message if the handle cannot be resolved, if given
+     * \return the handle, which is invalid if the path does not name a parameter or the type does not match
+     */
+    template<typename T>
+    ParamHandle<T> handle(std::string_view path, std::string* error = nullptr);
+
     /**
      * \brief Configures the object using the given configuration
      * 
@@ -387,9 +763,53 @@ public:
      * \param json the configuration as JSON
      */
     inline void configure(nlohmann::json const& json) {
-        for(auto const& it : params_) {
-            it.second->configure(json);
+        for(auto const& it : schema().params()) {
+            if(it.second->configure(*this, json) && provenance_) set_provenance(*it.second, nullptr);
+        }
+    }
+
+    /**
+     * \brief Configures the object using a layered configuration
+     * 
+     * Each parameter is configured from the topmost layer that assigns it, and that layer's source is recorded as the parameter's \ref provenance .
+     * Nested objects are configured recursively from all layers, so that the layers need not be merged.
+     * This is defined along with \ref provenance_config .
+     * 
+     * \param layers the configuration layers
+     */
+    void configure(ConfigLayers const& layers);
+
+    /**
+     * \brief Reports where the value of a parameter was configured from
+     * 
+     * The source is recorded when the object is configured using \ref ConfigLayers , and forgotten when the parameter is configured otherwise or the object is \ref reset .
+     * 
+     * \param name the name of the parameter
+     * \return the source of the layer that assigned the parameter, or an empty string if it was not assigned by any layer
+     */
+    inline std::string_view provenance(std::string_view const name) const {
+        if(provenance_) {
+            auto const* param = get_param(name);
+            for(auto const& [p, source] : *provenance_) {
+                if(p == param) return *source;
+            }
+        }
+        return {};
+    }
+
+    /**
+     * \brief Resets all parameters to their default values
+     * 
+     * Nested objects are reset recursively.
+     * Members are assigned their default values, so buffers they own, e.g., the capacity of strings, are retained.
+     */
+    inline void reset() {
+        for(auto const& it : schema().params()) {
+            it.second->reset(*this);
+            if(defaults_) it.second->configure(*this, *defaults_);
         }
+        if(annotations_) annotations_->clear();
+        provenance_.reset();
     }
 
     /**
@@ -399,8 +819,8 @@ public:
      */
     inline nlohmann::json config() const {
         nlohmann::json cfg;
-        for(auto const& it : params_) {
-            it.second->read_config(cfg);
+        for(auto const& it : schema().params()) {
+            it.second->read_config(*this, cfg);
         }
         return cfg;
     }
@@ -411,7 +831,7 @@ public:
      * \return the object's type name for registration purposes
      */
     inline std::string const& type_name() const {
-        return type_name_;
+        return *type_name_;
     }
 
     /**
@@ -420,7 +840,16 @@ public:
      * \return the object's descriptive text for display in a help screen
      */
     inline std::string const& description() const {
-        return desc_;
+        return *desc_;
+    }
+
+    /**
+     * \brief Provides access to the parameters marked as tunable, in the order they were marked
+     * 
+     * \return the list of tunable parameter names and their domains
+     */
+    inline auto const& tunables() const {
+        return schema().tunables();
     }
 
     /**
@@ -429,12 +858,41 @@ public:
      * \return the mapping of parameter names to parameters
      */
     inline auto const& params() const {
-        return params_;
+        return schema().params();
     }
 };
 
 using ObjectParam = ConfigObject::NestedParam;
 
+inline std::string_view ConfigParam::annotation(ConfigObject const& owner, ConfigParam const& param) {
+    if(owner.annotations_) {
+        for(auto const& [p, s] : *owner.annotations_) {
+            if(p == &param) return s;
+        }
+    }
+    return {};
+}
+
+inline void ConfigParam::annotate(ConfigObject& owner, ConfigParam const& param, std::string_view const annotation) {
+    if(!owner.annotations_) {
+        if(annotation.empty()) return;
+        owner.annotations_ = std::make_unique<std::vector<std::pair<ConfigParam const*, std::string>>>();
+    }
+
+    auto& annotations = *owner.annotations_;
+    for(auto it = annotations.begin(); it != annotations.end(); ++it) {
+        if(it->first == &param) {
+            if(annotation.empty()) {
+                annotations.erase(it);
+            } else {
+                it->second = annotation;
+            }
+            return;
+        }
+    }
+    if(!annotation.empty()) annotations.emplace_back(&param, annotation);
+}
+
 }
 
 #endif
@@ -1,25 +1,57 @@
 #ifndef _OOCMD_CONFIG_PARAM_HPP
 #define _OOCMD_CONFIG_PARAM_HPP
 
+#include <cstddef>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <typeinfo>
 
 #include <nlohmann/json.hpp>
+#include <oocmd/util/intern.hpp>
 
 namespace oocmd {
 
+class ConfigObject;
+
+// the key under which the type name assigned to an object parameter is stored in a configuration
+inline constexpr char TYPE_NAME_KEY[] = "@type";
+
 // abstract base for configuration parameters
+// parameters are shared by all instances of a config object type (see ConfigSchema) and bind to members by their offset within the owning object
 class ConfigParam {
 protected:
-    char        short_name_;
-    std::string name_;
-    std::string desc_;
+    // names and descriptions are interned, so all instances of a config object type share them
+    char               short_name_;
+    std::string const* name_;
+    std::string const* desc_;
+
+    // computes the offset of a member within the owning object
+    static inline ptrdiff_t offset_of(ConfigObject const& owner, void const* member) {
+        return reinterpret_cast<char const*>(member) - reinterpret_cast<char const*>(&owner);
+    }
+
+    // resolves a member of the owning object by its offset
+    template<typename T>
+    static inline T& member(ConfigObject& owner, ptrdiff_t const offset) {
+        return *reinterpret_cast<T*>(reinterpret_cast<char*>(&owner) + offset);
+    }
+
+    template<typename T>
+    static inline T const& member(ConfigObject const& owner, ptrdiff_t const offset) {
+        return *reinterpret_cast<T const*>(reinterpret_cast<char const*>(&owner) + offset);
+    }
+
+    // per-instance annotations, e.g., the machine-dependent expression that a value was resolved from, are stored in the owning object
+    // these are defined along with ConfigObject
+    static std::string_view annotation(ConfigObject const& owner, ConfigParam const& param);
+    static void annotate(ConfigObject& owner, ConfigParam const& param, std::string_view annotation);
 
 public:
-    inline ConfigParam() {
+    inline ConfigParam() : short_name_(0), name_(&intern("")), desc_(name_) {
     }
 
-    inline ConfigParam(const char short_name, std::string&& name, std::string&& desc) : short_name_(short_name), name_(std::move(name)), desc_(std::move(desc)) {
+    inline ConfigParam(const char short_name, std::string_view name, std::string_view desc) : short_name_(short_name), name_(&intern(name)), desc_(&intern(desc)) {
     }
 
     ConfigParam(ConfigParam const&) = delete;
@@ -27,16 +59,49 @@ public:
     ConfigParam(ConfigParam&&) = default;
     ConfigParam& operator=(ConfigParam&&) = default;
 
+    virtual ~ConfigParam() = default;
+
     inline bool has_short_name() const { return short_name_ != 0; }
     inline char short_name() const { return short_name_; }
-    inline std::string const& name() const { return name_; }
-    inline std::string const& description() const { return desc_; }
+    inline std::string const& name() const { return *name_; }
+    inline std::string const& description() const { return *desc_; }
 
     virtual bool is_flag() const = 0;
     virtual bool is_list() const = 0;
 
-    virtual bool configure(nlohmann::json const& json) const = 0;
-    virtual void read_config(nlohmann::json& dst) const = 0;
+    // live parameters may be assigned while the configured program is running, e.g., via the control socket of an application
+    inline virtual bool is_live() const { return false; }
+
+    virtual bool configure(ConfigObject& owner, nlohmann::json const& json) const = 0;
+    virtual void read_config(ConfigObject const& owner, nlohmann::json& dst) const = 0;
+
+    // assigns a single value given as a string, as it would be given in a command line, which for list parameters either replaces the list or is appended to it
+    // the default implementation configures the parameter via JSON, which parameter types override in order to avoid building JSON
+    inline virtual bool assign(ConfigObject& owner, std::string_view const value, bool const append) const {
+        (void)append;
+        nlohmann::json json;
+        json[name()] = std::string(value);
+        return configure(owner, json);
+    }
+
+    // tests, without assigning anything, whether the given value would be accepted and stored as a single string, e.g., a cpulist rather than a number
+    // this is used to decide whether a comma-separated value is a list of values to sweep over
+    inline virtual bool accepts_as_string(std::string_view const value) const { (void)value; return false; }
+
+    // resets the bound member of the owning object to its default value
+    virtual void reset(ConfigObject& owner) const = 0;
+
+    // tests whether the bound member of the owning object holds the default value, which the first instance of the type had initially
+    // parameters that cannot tell report false, and parameters targeting nested objects report true, as those keep track of their own defaults
+    inline virtual bool has_default_value(ConfigObject const& owner) const { (void)owner; return true; }
+
+    // the offset of the bound member within the owning object
+    virtual ptrdiff_t offset() const = 0;
+
+    // the type and address of the member bound to the parameter, which allow for typed access via a ParamHandle
+    // parameters that are not bound to a single value report void and do not provide an address
+    inline virtual std::type_info const& bound_type() const { return typeid(void); }
+    inline virtual void const* bound(ConfigObject const& owner) const { (void)owner; return nullptr; }
 
     virtual std::string value_type_str() const = 0;
     virtual std::string default_value_str() const = 0;
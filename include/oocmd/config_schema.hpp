@@ -0,0 +1,248 @@
+#ifndef _OOCMD_CONFIG_SCHEMA_HPP
+#define _OOCMD_CONFIG_SCHEMA_HPP
+
+#include <array>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <oocmd/config_param.hpp>
+#include <oocmd/util/tuning_domain.hpp>
+
+namespace oocmd {
+
+/**
+ * \brief The parameters declared by a config object type
+ *
+ * Every instance of a config object type declares the same parameters, which are bound to its members by their offset within the object.
+ * Therefore, the schema is built only once per type, namely by the first instance, and is shared by all instances afterwards.
+ * Schemas are kept in a process-wide registry, keyed by the type, and are never released.
+ * Since parameters do not refer to any particular instance, objects can be moved and copied freely, e.g., stored by value in a \c std::vector .
+ *
+ * A schema is registered as soon as the first instance starts declaring parameters, and it is \em complete once that instance has been constructed.
+ * Further instances constructed on the same thread adopt it right away, since the first instance must have been constructed by then.
+ * Instances constructed concurrently on other threads before the schema is complete cannot share it; they build a private schema that is released along with the last instance using it.
+ * If the construction of the first instance fails, the incomplete schema is discarded.
+ *
+ * The schema of a derived type contains the parameters of its base type in addition to its own.
+ */
+class ConfigSchema {
+private:
+    std::type_info const* type_;
+    std::shared_ptr<ConfigSchema const> base_; // the base type's schema if it is private, which must outlive this schema
+    std::vector<std::unique_ptr<ConfigParam>> own_params_; // the parameters declared by the type itself rather than inherited
+    std::unordered_map<std::string_view, ConfigParam const*> params_;
+    std::unordered_map<char, std::string_view> short_params_;
+    std::vector<std::pair<std::string, TuningDomain>> tunables_;
+
+    // the state of a registered schema
+    struct Entry {
+        std::unique_ptr<ConfigSchema> schema;
+        bool complete = false;
+        std::thread::id builder; // the thread constructing the first instance, while incomplete
+        int exceptions = 0;      // the number of uncaught exceptions when the first instance started declaring
+    };
+
+    struct Registry {
+        std::mutex mutex;
+        std::unordered_map<std::type_index, Entry> schemas;
+    };
+
+    static Registry& registry() {
+        static Registry registry;
+        return registry;
+    }
+
+    // a direct-mapped cache of published schemas, so that looking up the schema for another instance does not require the registry's lock
+    struct Cache {
+        static constexpr size_t SIZE = 64;
+        std::array<std::pair<std::type_info const*, ConfigSchema const*>, SIZE> entries{};
+
+        inline auto& slot(std::type_info const& type) { return entries[(reinterpret_cast<uintptr_t>(&type) >> 4) % SIZE]; }
+    };
+
+    static Cache& cache() {
+        thread_local Cache cache;
+        return cache;
+    }
+
+public:
+    /**
+     * \brief Provides access to the empty schema, which is used by objects that do not declare any parameters
+     *
+     * \return the empty schema
+     */
+    static inline ConfigSchema const& empty() {
+        static ConfigSchema const empty(typeid(void));
+        return empty;
+    }
+
+    /**
+     * \brief The outcome of an instance starting to declare the parameters of its type
+     */
+    struct Declaration {
+        ConfigSchema const* adopted = nullptr;      ///< the schema to adopt, if the instance does not build it
+        ConfigSchema* building = nullptr;           ///< the schema that the instance builds by declaring parameters, if any
+        std::shared_ptr<ConfigSchema const> owner;  ///< the owner of the schema if it is private to the instance and its copies
+    };
+
+    /**
+     * \brief Looks up the complete schema of the given type
+     *
+     * \param type the type
+     * \return the complete schema, or \c nullptr if the type has no complete schema
+     */
+    static inline ConfigSchema const* find(std::type_info const& type) {
+        auto& entry = cache().slot(type);
+        if(entry.first == &type) return entry.second;
+
+        ConfigSchema const* schema = nullptr;
+        {
+            auto& r = registry();
+            std::lock_guard lock(r.mutex);
+            auto it = r.schemas.find(type);
+            if(it != r.schemas.end() && it->second.complete) schema = it->second.schema.get();
+        }
+
+        if(schema) entry = { &type, schema };
+        return schema;
+    }
+
+    /**
+     * \brief Determines the schema of an instance of the given type that starts declaring parameters
+     *
+     * If the type's schema is complete, it is adopted.
+     * If it is incomplete and being built on the calling thread, it is adopted and completed, because the instance building it must have been constructed by now.
+     * If it is being built on another thread, or if the base type's schema is private, the instance builds a private schema.
+     * Otherwise, the instance builds the type's schema, which is registered right away.
+     *
+     * \param type the type
+     * \param base the schema of the base type, whose parameters are inherited, or \c nullptr
+     * \param base_owner the owner of the base type's schema if it is private, or \c nullptr
+     * \return the schema to adopt or to build
+     */
+    static inline Declaration declare(std::type_info const& type, ConfigSchema const* base, std::shared_ptr<ConfigSchema const> base_owner) {
+        if(auto const* complete = find(type)) return { complete, nullptr, nullptr };
+
+        {
+            auto& r = registry();
+            std::lock_guard lock(r.mutex);
+            auto it = r.schemas.find(type);
+            if(it != r.schemas.end()) {
+                auto& entry = it->second;
+                if(entry.complete) return { entry.schema.get(), nullptr, nullptr };
+                if(entry.builder == std::this_thread::get_id()) {
+                    entry.complete = true;
+                    return { entry.schema.get(), nullptr, nullptr };
+                }
+            } else if(!base_owner) {
+                auto& entry = r.schemas[type];
+                entry.schema = std::make_unique<ConfigSchema>(type, base);
+                entry.builder = std::this_thread::get_id();
+                entry.exceptions = std::uncaught_exceptions();
+                return { nullptr, entry.schema.get(), nullptr };
+            }
+        }
+
+        auto schema = std::make_shared<ConfigSchema>(type, base);
+        schema->base_ = std::move(base_owner);
+        auto* const building = schema.get();
+        return { nullptr, building, std::move(schema) };
+    }
+
+    /**
+     * \brief Concludes building a schema
+     *
+     * A registered schema becomes complete, so that instances on any thread adopt it, unless the construction of the instance building it failed,
+     * which is detected by an exception being thrown since it started declaring parameters; in that case, the incomplete schema is discarded.
+     * Private schemas are not affected.
+     *
+     * \param schema the schema
+     * \param may_fail whether the construction of the instance building the schema may have failed, i.e., whether the instance is being destroyed
+     */
+    static inline void conclude(ConfigSchema const& schema, bool const may_fail) {
+        auto& r = registry();
+        std::lock_guard lock(r.mutex);
+        auto it = r.schemas.find(*schema.type_);
+        if(it == r.schemas.end() || it->second.schema.get() != &schema || it->second.complete) return;
+
+        if(may_fail && std::uncaught_exceptions() > it->second.exceptions) {
+            r.schemas.erase(it);
+        } else {
+            it->second.complete = true;
+        }
+    }
+
+    /**
+     * \brief Constructs a schema for the given type
+     *
+     * \param type the type
+     * \param base the schema of the base type, whose parameters are inherited, or \c nullptr
+     */
+    inline ConfigSchema(std::type_info const& type, ConfigSchema const* base = nullptr) : type_(&type) {
+        if(base) {
+            params_ = base->params_;
+            short_params_ = base->short_params_;
+            tunables_ = base->tunables_;
+        }
+    }
+
+    ConfigSchema(ConfigSchema const&) = delete;
+    ConfigSchema& operator=(ConfigSchema const&) = delete;
+
+    /**
+     * \brief Reports the type that the schema was built for
+     *
+     * \return the type
+     */
+    inline std::type_info const& type() const { return *type_; }
+
+    /**
+     * \brief Adds a parameter
+     *
+     * \param param the parameter
+     */
+    inline void add(std::unique_ptr<ConfigParam> param) {
+        std::string_view const key = param->name();
+        if(param->has_short_name()) short_params_.emplace(param->short_name(), key);
+        params_.emplace(key, param.get());
+        own_params_.push_back(std::move(param));
+    }
+
+    /**
+     * \brief Marks a parameter as tunable
+     *
+     * \param name the name of the parameter
+     * \param domain the values to search over
+     */
+    inline void add_tunable(std::string const& name, TuningDomain domain) {
+        tunables_.emplace_back(name, std::move(domain));
+    }
+
+    inline ConfigParam const* get(std::string_view const name) const {
+        auto it = params_.find(name);
+        return (it != params_.end()) ? it->second : nullptr;
+    }
+
+    inline ConfigParam const* get(char const short_name) const {
+        auto it = short_params_.find(short_name);
+        return (it != short_params_.end()) ? get(it->second) : nullptr;
+    }
+
+    inline auto const& params() const { return params_; }
+    inline auto const& own_params() const { return own_params_; }
+    inline auto const& tunables() const { return tunables_; }
+};
+
+}
+
+#endif
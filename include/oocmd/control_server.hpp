@@ -0,0 +1,278 @@
+#ifndef _OOCMD_CONTROL_SERVER_HPP
+#define _OOCMD_CONTROL_SERVER_HPP
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <nlohmann/json.hpp>
+
+#include <oocmd/config_object.hpp>
+#include <oocmd/provenance.hpp>
+#include <oocmd/util/process_setup.hpp>
+#include <oocmd/util/resolve_param.hpp>
+
+namespace oocmd {
+
+/**
+ * \brief Serves a Unix domain socket for inspecting and adjusting the configuration of a running program
+ *
+ * The server runs on a dedicated thread and handles one connection at a time.
+ * Each line received is a command, which is answered by a single line:
+ * either <tt>ok</tt> , possibly followed by a space and a JSON value, or <tt>error</tt> followed by a space and a message.
+ * The following commands are supported:
+ * - <tt>get PATH</tt> reports the value of the parameter with the given dot-separated path, e.g., <tt>get cache.shards</tt> ,
+ * - <tt>set PATH=VALUE</tt> assigns a value to a \ref ConfigObject::param "live parameter" as it would be given in a command line,
+ * - <tt>dump</tt> reports the entire configuration,
+ * - <tt>diff-from-defaults</tt> reports the parameters whose values differ from the defaults as an object mapping their paths to their values, and
+ * - <tt>provenance</tt> reports the sources that parameters were configured from as an object mapping their paths to the sources (see \ref provenance_config ).
+ *
+ * Only live parameters, which are bound to atomic variables, may be assigned, since other parameters are read by the program without synchronization.
+ * Conversely, reading other parameters is only safe as long as the program does not assign them itself.
+ * \ref Lazy objects are never constructed by the server: reading a parameter of a lazy object that does not exist yet reports its default, and assigning it is rejected.
+ *
+ * Typically, a server is not constructed directly but requested from an \ref Application using <tt>--oocmd.control=PATH</tt> .
+ */
+class ControlServer {
+private:
+    ConfigObject* target_;
+    nlohmann::json defaults_; // the default configuration, or null if unknown
+    std::string path_;
+    std::string error_;
+
+    int listen_fd_ = -1;
+    int wake_fd_ = -1; // signalled in order to stop the server thread
+    std::thread thread_;
+
+    // flattens a configuration into an object mapping dot-separated paths to values
+    static void flatten(nlohmann::json const& config, std::string const& prefix, nlohmann::json& out) {
+        for(auto it = config.begin(); it != config.end(); ++it) {
+            auto const path = prefix + it.key();
+            if(it->is_object()) {
+                flatten(*it, path + ".", out);
+            } else {
+                out[path] = *it;
+            }
+        }
+    }
+
+    static std::string_view trim(std::string_view s) {
+        auto const first = s.find_first_not_of(" \t\r");
+        if(first == std::string_view::npos) return {};
+        auto const last = s.find_last_not_of(" \t\r");
+        return s.substr(first, last - first + 1);
+    }
+
+    static std::string failure(std::string_view const what, std::string_view const arg) {
+        std::string msg("error ");
+        msg.append(what).append(": ").append(arg);
+        return msg;
+    }
+
+    // waits until the given file descriptor is readable, returning false if the server is to stop
+    bool wait(int const fd) const {
+        pollfd fds[2] = { { fd, POLLIN, 0 }, { wake_fd_, POLLIN, 0 } };
+        while(poll(fds, 2, -1) < 0) {
+            if(errno != EINTR) return false;
+        }
+        return !(fds[1].revents & POLLIN);
+    }
+
+    void handle(int const conn) {
+        std::string buffer;
+        char chunk[4096];
+        while(wait(conn)) {
+            auto const n = ::read(conn, chunk, sizeof(chunk));
+            if(n <= 0) return;
+            buffer.append(chunk, size_t(n));
+
+            size_t begin = 0;
+            for(auto end = buffer.find('\n'); end != std::string::npos; end = buffer.find('\n', begin)) {
+                auto const line = trim(std::string_view(buffer).substr(begin, end - begin));
+                begin = end + 1;
+                if(line.empty()) continue;
+
+                auto response = execute(line);
+                response.push_back('\n');
+                if(send(conn, response.data(), response.size(), MSG_NOSIGNAL) != ssize_t(response.size())) return;
+            }
+            buffer.erase(0, begin);
+        }
+    }
+
+    void serve() {
+        while(wait(listen_fd_)) {
+            int const conn = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+            if(conn < 0) continue;
+            handle(conn);
+            ::close(conn);
+        }
+    }
+
+    void close() {
+        if(thread_.joinable()) {
+            uint64_t const one = 1;
+            [[maybe_unused]] auto const n = ::write(wake_fd_, &one, sizeof(one));
+            thread_.join();
+        }
+        if(listen_fd_ >= 0) {
+            ::close(listen_fd_);
+            ::unlink(path_.c_str());
+            listen_fd_ = -1;
+        }
+        if(wake_fd_ >= 0) {
+            ::close(wake_fd_);
+            wake_fd_ = -1;
+        }
+    }
+
+public:
+    /**
+     * \brief Starts serving a control socket for the given object
+     *
+     * An existing socket at the given path, e.g., left behind by a previous run, is replaced.
+     * If the socket cannot be served, the server is not \ref good and the \ref error is reported.
+     *
+     * \param target the object to control, which must outlive the server
+     * \param path the path of the socket
+     * \param defaults the default configuration of the object, which is required by <tt>diff-from-defaults</tt>
+     */
+    inline ControlServer(ConfigObject& target, std::string path, nlohmann::json defaults = nlohmann::json())
+        : target_(&target), defaults_(std::move(defaults)), path_(std::move(path)) {
+
+        target.schema(); // make sure the schema is published before it is accessed concurrently
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if(path_.empty() || path_.size() >= sizeof(addr.sun_path)) {
+            error_ = "invalid control socket path: " + path_;
+            return;
+        }
+        std::memcpy(addr.sun_path, path_.c_str(), path_.size() + 1);
+
+        struct stat st;
+        if(::stat(path_.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) ::unlink(path_.c_str());
+
+        int const fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if(fd < 0) {
+            error_ = process::system_error("failed to create control socket");
+            return;
+        }
+        if(bind(fd, reinterpret_cast<sockaddr const*>(&addr), sizeof(addr)) != 0 || listen(fd, 4) != 0) {
+            error_ = process::system_error("failed to bind control socket " + path_);
+            ::close(fd);
+            return;
+        }
+        listen_fd_ = fd;
+
+        wake_fd_ = eventfd(0, EFD_CLOEXEC);
+        if(wake_fd_ < 0) {
+            error_ = process::system_error("failed to create control socket");
+            close();
+            return;
+        }
+
+        thread_ = std::thread([this]{ serve(); });
+    }
+
+    ControlServer(ControlServer const&) = delete;
+    ControlServer& operator=(ControlServer const&) = delete;
+
+    /**
+     * \brief Stops serving and removes the socket
+     */
+    inline ~ControlServer() { close(); }
+
+    /**
+     * \brief Tests whether the socket is being served
+     *
+     * \return true if the socket is being served
+     * \return false if it could not be created
+     */
+    inline bool good() const { return thread_.joinable(); }
+
+    /**
+     * \brief Reports why the socket could not be served
+     *
+     * \return the error message, or an empty string if the socket is being served
+     */
+    inline std::string const& error() const { return error_; }
+
+    /**
+     * \brief Reports the path of the socket
+     *
+     * \return the path of the socket
+     */
+    inline std::string const& path() const { return path_; }
+
+    /**
+     * \brief Executes a single command as if it had been received via the socket
+     *
+     * \param command the command
+     * \return the response, not including a line break
+     */
+    inline std::string execute(std::string_view const command) const {
+        auto const space = command.find(' ');
+        auto const cmd = command.substr(0, space);
+        auto const arg = space != std::string_view::npos ? trim(command.substr(space + 1)) : std::string_view();
+
+        if(cmd == "get") {
+            // never construct lazy objects, which the program may be accessing concurrently
+            ConfigObject const* owner;
+            auto const* param = resolve_param(std::as_const(*target_), arg, owner);
+            if(!param) return failure("unknown parameter", arg);
+
+            nlohmann::json value;
+            param->read_config(*owner, value);
+            return "ok " + value[param->name()].dump();
+        } else if(cmd == "set") {
+            auto const eq = arg.find('=');
+            if(eq == std::string_view::npos) return failure("expected PATH=VALUE", arg);
+
+            auto const path = arg.substr(0, eq);
+            ConfigObject const* prototype;
+            auto const* param = resolve_param(std::as_const(*target_), path, prototype);
+            if(!param) return failure("unknown parameter", path);
+            if(!param->is_live()) return failure("parameter is not live", path);
+
+            // a lazy object that does not exist yet must not be constructed here, nor would assigning its prototype have any effect
+            ConfigObject* owner;
+            if(!resolve_param(*target_, path, owner, false)) return failure("parameter belongs to an object that has not been constructed", path);
+            if(!param->assign(*owner, arg.substr(eq + 1), false)) return failure("invalid value", arg);
+            return "ok";
+        } else if(cmd == "dump") {
+            return "ok " + target_->config().dump();
+        } else if(cmd == "provenance") {
+            return "ok " + provenance_config(*target_).dump();
+        } else if(cmd == "diff-from-defaults") {
+            if(defaults_.is_null()) return failure("defaults are unavailable for", target_->type_name());
+
+            nlohmann::json current, defaults;
+            flatten(target_->config(), "", current);
+            flatten(defaults_, "", defaults);
+
+            auto diff = nlohmann::json::object();
+            for(auto it = current.begin(); it != current.end(); ++it) {
+                auto const d = defaults.find(it.key());
+                if(d == defaults.end() || *d != *it) diff[it.key()] = *it;
+            }
+            return "ok " + diff.dump();
+        } else {
+            return failure("unknown command", cmd);
+        }
+    }
+};
+
+}
+
+#endif
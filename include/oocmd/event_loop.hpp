@@ -0,0 +1,315 @@
+#ifndef _OOCMD_EVENT_LOOP_HPP
+#define _OOCMD_EVENT_LOOP_HPP
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include <sys/epoll.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <oocmd/task.hpp>
+
+namespace oocmd {
+
+/**
+ * \brief A single-threaded event loop that drives \ref Task coroutines, backed by \c epoll
+ *
+ * Coroutines running on the loop can wait for timers and for file descriptors to become readable or writable.
+ * Timers are kept in a heap and determine the timeout of \c epoll_wait , so they do not require any file descriptors.
+ * File descriptors are registered only while a coroutine is waiting for them.
+ * Only one coroutine may wait for a given file descriptor at a time.
+ *
+ * Regular files, which cannot be registered with \c epoll , are always considered ready.
+ * File descriptors used with \ref read and \ref write should be non-blocking, otherwise the whole loop blocks until the operation completes.
+ *
+ * Typically, a loop is not constructed directly; instead, an \ref Application drives asynchronous \c run functions on a loop that is accessible via \ref Application::loop .
+ */
+class EventLoop {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * \brief Awaits a point in time
+     */
+    struct SleepAwaiter {
+        EventLoop& loop;
+        Clock::time_point deadline;
+
+        inline bool await_ready() const { return deadline <= Clock::now(); }
+        inline void await_suspend(std::coroutine_handle<> h) { loop.timers_.push({ deadline, loop.num_timers_++, h }); }
+        inline void await_resume() const {}
+    };
+
+    /**
+     * \brief Awaits events on a file descriptor and resumes with the events that occurred
+     */
+    struct FdAwaiter {
+        EventLoop& loop;
+        int fd;
+        uint32_t events;
+        uint32_t revents = 0;
+        std::coroutine_handle<> handle = nullptr;
+
+        inline bool await_ready() const { return false; }
+
+        inline bool await_suspend(std::coroutine_handle<> h) {
+            handle = h;
+
+            epoll_event ev{};
+            ev.events = events | EPOLLONESHOT;
+            ev.data.ptr = this;
+            if(epoll_ctl(loop.epoll_fd_, EPOLL_CTL_ADD, fd, &ev) != 0) {
+                // regular files cannot be registered, but are always ready
+                revents = (errno == EPERM) ? events : uint32_t(EPOLLERR);
+                return false;
+            }
+
+            ++loop.waiting_;
+            return true;
+        }
+
+        inline uint32_t await_resume() const { return revents; }
+    };
+
+    /**
+     * \brief Suspends the awaiting coroutine and reschedules it after all coroutines that are currently ready
+     */
+    struct YieldAwaiter {
+        EventLoop& loop;
+
+        inline bool await_ready() const { return false; }
+        inline void await_suspend(std::coroutine_handle<> h) { loop.ready_.push_back(h); }
+        inline void await_resume() const {}
+    };
+
+private:
+    struct Timer {
+        Clock::time_point deadline;
+        uint64_t seq; // breaks ties, so that timers with the same deadline expire in order
+        std::coroutine_handle<> handle;
+
+        inline bool operator>(Timer const& other) const {
+            return deadline > other.deadline || (deadline == other.deadline && seq > other.seq);
+        }
+    };
+
+    static constexpr size_t MAX_EVENTS = 64;
+
+    int epoll_fd_;
+    std::deque<std::coroutine_handle<>> ready_;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<>> timers_;
+    uint64_t num_timers_ = 0;
+    size_t waiting_ = 0; // the number of coroutines waiting for a file descriptor
+    std::vector<Task<>> spawned_;
+
+    // resumes all coroutines that are ready, including those that become ready meanwhile
+    inline void resume_ready() {
+        while(!ready_.empty()) {
+            auto const h = ready_.front();
+            ready_.pop_front();
+            h.resume();
+        }
+    }
+
+    // releases completed spawned tasks, rethrowing any exception that escaped them
+    inline void reap() {
+        for(auto& task : spawned_) {
+            if(task.done()) task.result();
+        }
+        std::erase_if(spawned_, [](Task<> const& task){ return task.done(); });
+    }
+
+    // waits for file descriptor events or the next timer and schedules the coroutines that can continue
+    inline bool poll() {
+        int timeout = -1;
+        if(!timers_.empty()) {
+            auto const now = Clock::now();
+            auto const deadline = timers_.top().deadline;
+            if(deadline <= now) {
+                timeout = 0;
+            } else {
+                auto const ms = std::chrono::ceil<std::chrono::milliseconds>(deadline - now).count();
+                timeout = int(std::min<decltype(ms)>(ms, INT_MAX));
+            }
+        }
+
+        std::array<epoll_event, MAX_EVENTS> events;
+        auto const n = epoll_wait(epoll_fd_, events.data(), int(MAX_EVENTS), timeout);
+        if(n < 0 && errno != EINTR) return false;
+
+        for(int i = 0; i < n; i++) {
+            auto* const awaiter = static_cast<FdAwaiter*>(events[i].data.ptr);
+            awaiter->revents = events[i].events;
+            epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, awaiter->fd, nullptr);
+            --waiting_;
+            ready_.push_back(awaiter->handle);
+        }
+
+        auto const now = Clock::now();
+        while(!timers_.empty() && timers_.top().deadline <= now) {
+            ready_.push_back(timers_.top().handle);
+            timers_.pop();
+        }
+        return true;
+    }
+
+public:
+    /**
+     * \brief Creates an event loop
+     *
+     * If the \c epoll instance cannot be created, the loop is not \ref good .
+     */
+    inline EventLoop() : epoll_fd_(epoll_create1(EPOLL_CLOEXEC)) {
+    }
+
+    EventLoop(EventLoop const&) = delete;
+    EventLoop& operator=(EventLoop const&) = delete;
+
+    inline ~EventLoop() {
+        spawned_.clear(); // destroy pending coroutines before closing the epoll instance
+        if(epoll_fd_ >= 0) ::close(epoll_fd_);
+    }
+
+    /**
+     * \brief Tests whether the loop is usable
+     *
+     * \return true if the \c epoll instance was created
+     * \return false otherwise
+     */
+    inline bool good() const { return epoll_fd_ >= 0; }
+
+    /**
+     * \brief Runs the loop until the given task has completed
+     *
+     * The task is started if it has not been started yet.
+     * Tasks that were \ref spawn "spawned" and have not completed by then remain suspended until the loop is run again or destroyed.
+     *
+     * \param task the task to drive
+     * \return true if the task has completed, so that its \ref Task::result "result" can be retrieved
+     * \return false if the task can never complete because it awaits neither a timer nor a file descriptor, or if waiting for events failed
+     */
+    template<typename T>
+    inline bool run(Task<T>& task) {
+        if(!good()) return false;
+        if(!task.done()) ready_.push_back(task.handle());
+
+        while(true) {
+            resume_ready();
+            reap();
+            if(task.done()) return true;
+            if(timers_.empty() && waiting_ == 0) return false;
+            if(!poll()) return false;
+        }
+    }
+
+    /**
+     * \brief Starts a task that runs concurrently with the awaiting coroutine
+     *
+     * The task is owned by the loop.
+     * If an exception escapes the task, it is rethrown by \ref run .
+     *
+     * \param task the task
+     */
+    inline void spawn(Task<> task) {
+        ready_.push_back(task.handle());
+        spawned_.push_back(std::move(task));
+    }
+
+    /**
+     * \brief Suspends the awaiting coroutine for the given duration
+     *
+     * \param duration the duration
+     * \return an awaitable
+     */
+    template<typename Rep, typename Period>
+    inline SleepAwaiter sleep_for(std::chrono::duration<Rep, Period> const duration) {
+        return SleepAwaiter{ *this, Clock::now() + std::chrono::ceil<Clock::duration>(duration) };
+    }
+
+    /**
+     * \brief Suspends the awaiting coroutine until the given point in time
+     *
+     * \param deadline the point in time
+     * \return an awaitable
+     */
+    inline SleepAwaiter sleep_until(Clock::time_point const deadline) {
+        return SleepAwaiter{ *this, deadline };
+    }
+
+    /**
+     * \brief Suspends the awaiting coroutine until the given file descriptor is readable
+     *
+     * \param fd the file descriptor
+     * \return an awaitable that produces the \c epoll events that occurred
+     */
+    inline FdAwaiter readable(int const fd) { return FdAwaiter{ *this, fd, EPOLLIN }; }
+
+    /**
+     * \brief Suspends the awaiting coroutine until the given file descriptor is writable
+     *
+     * \param fd the file descriptor
+     * \return an awaitable that produces the \c epoll events that occurred
+     */
+    inline FdAwaiter writable(int const fd) { return FdAwaiter{ *this, fd, EPOLLOUT }; }
+
+    /**
+     * \brief Lets other coroutines that are ready run before continuing
+     *
+     * \return an awaitable
+     */
+    inline YieldAwaiter yield() { return YieldAwaiter{ *this }; }
+
+    /**
+     * \brief Reads from a file descriptor, waiting until data is available
+     *
+     * \param fd the file descriptor
+     * \param buffer the buffer to read into
+     * \param size the maximum number of bytes to read
+     * \return a task producing the number of bytes read, zero at the end of the file, or -1 on error, in which case \c errno is set
+     */
+    inline Task<ssize_t> read(int const fd, void* buffer, size_t const size) {
+        while(true) {
+            auto const n = ::read(fd, buffer, size);
+            if(n >= 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) co_return n;
+            co_await readable(fd);
+        }
+    }
+
+    /**
+     * \brief Writes all given data to a file descriptor, waiting whenever it is not writable
+     *
+     * \param fd the file descriptor
+     * \param data the data to write
+     * \param size the number of bytes to write
+     * \return a task producing the number of bytes written, or -1 on error, in which case \c errno is set
+     */
+    inline Task<ssize_t> write(int const fd, void const* data, size_t const size) {
+        size_t written = 0;
+        while(written < size) {
+            auto const n = ::write(fd, static_cast<char const*>(data) + written, size - written);
+            if(n >= 0) {
+                written += size_t(n);
+            } else if(errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                co_await writable(fd);
+            } else {
+                co_return -1;
+            }
+        }
+        co_return ssize_t(written);
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef _OOCMD_LAZY_HPP
+#define _OOCMD_LAZY_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <oocmd/config_object.hpp>
+
+namespace oocmd {
+
+/**
+ * \brief A nested config object that is only constructed when it is needed
+ *
+ * Like a member object declared as an object parameter, a lazy object is configured recursively, e.g., via <tt>--member.param=value</tt> .
+ * However, the object is only constructed when it is first configured or accessed.
+ *
+ * Matching configurations against the object's parameters and printing usage information requires its schema, i.e., its parameters.
+ * For this purpose, a single shared prototype instance is constructed per object type, but only if the parameter is actually used in the command line or if usage information is printed.
+ * Likewise, reporting the configuration of an object that was never constructed reports the configuration of the prototype, i.e., the defaults.
+ * Only non-const access constructs the object, so that const access is safe from concurrent threads as long as the lazy object is not modified.
+ *
+ * \tparam T the object type, which must be default constructible
+ */
+template<DerivedFromConfigObject T>
+class Lazy {
+    static_assert(std::default_initializable<T>, "lazily constructed objects must be default constructible");
+
+private:
+    std::unique_ptr<T> object_;
+
+public:
+    /**
+     * \brief Provides access to the shared prototype of the object type
+     *
+     * The prototype is constructed on first access and is never configured.
+     *
+     * \return the prototype
+     */
+    static inline T const& prototype() {
+        static T const prototype;
+        return prototype;
+    }
+
+    // the parameter type used to bind lazy objects to config objects
+    class Param : public ConfigObject::NestedParam {
+    private:
+        ptrdiff_t offset_; // the offset of the lazy object within the owning object
+
+    public:
+        inline Param() : offset_(0) {
+        }
+
+        inline Param(ConfigObject const& owner, const char short_name, std::string_view name, Lazy& ref, std::string_view desc)
+            : ConfigObject::NestedParam(short_name, name, desc), offset_(offset_of(owner, &ref)) {
+        }
+
+        inline ConfigObject const& object(ConfigObject const& owner) const override { return member<Lazy>(owner, offset_).get(); }
+
+        inline ConfigObject& object(ConfigObject& owner) const override { return member<Lazy>(owner, offset_).get(); }
+        inline bool constructed(ConfigObject const& owner) const override { return member<Lazy>(owner, offset_).constructed(); }
+
+        inline bool configure(ConfigObject& owner, nlohmann::json const& json) const override {
+            if(json.contains(name())) {
+                auto const& v = json[name()];
+                if(v.is_object() && !v.empty()) object(owner).configure(v);
+                return true;
+            } else {
+                return false;
+            }
+        }
+
+        inline void read_config(ConfigObject const& owner, nlohmann::json& dst) const override {
+            auto sub = object(owner).config();
+            if(!sub.is_null()) {
+                dst[name()] = sub;
+            }
+        }
+
+        inline bool assign(ConfigObject&, std::string_view const value, bool) const override { return value == prototype().type_name(); }
+
+        inline void reset(ConfigObject& owner) const override {
+            auto& lazy = member<Lazy>(owner, offset_);
+            if(lazy.constructed()) lazy.get().reset();
+        }
+
+        inline ptrdiff_t offset() const override { return offset_; }
+
+        inline std::string default_value_str() const override { return std::string(prototype().type_name()); }
+    };
+
+    /**
+     * \brief Constructs a lazy object without constructing the object itself
+     */
+    inline Lazy() {
+    }
+
+    /**
+     * \brief Copies a lazy object, constructing a copy of the object only if it has been constructed
+     *
+     * \param other the lazy object to copy
+     */
+    inline Lazy(Lazy const& other) requires std::copy_constructible<T> : object_(other.object_ ? std::make_unique<T>(*other.object_) : nullptr) {
+    }
+
+    inline Lazy& operator=(Lazy const& other) requires std::copy_constructible<T> {
+        if(this != &other) object_ = other.object_ ? std::make_unique<T>(*other.object_) : nullptr;
+        return *this;
+    }
+
+    Lazy(Lazy&&) = default;
+    Lazy& operator=(Lazy&&) = default;
+
+    /**
+     * \brief Tests whether the object has been constructed
+     *
+     * \return true if the object has been constructed
+     * \return false otherwise
+     */
+    inline bool constructed() const { return bool(object_); }
+
+    /**
+     * \brief Provides access to the object, constructing it if necessary
+     *
+     * \return a reference to the object
+     */
+    inline T& get() {
+        if(!object_) object_ = std::make_unique<T>();
+        return *object_;
+    }
+
+    /**
+     * \brief Provides read access to the object without constructing it
+     *
+     * If the object has not been constructed, the prototype is returned instead, which holds the defaults.
+     *
+     * \return a reference to the object, or to the prototype if the object has not been constructed
+     */
+    inline T const& get() const { return object_ ? *object_ : prototype(); }
+
+    inline T& operator*() { return get(); }
+    inline T const& operator*() const { return get(); }
+    inline T* operator->() { return &get(); }
+    inline T const* operator->() const { return &get(); }
+};
+
+}
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef _OOCMD_OPTIONS_HPP
+#define _OOCMD_OPTIONS_HPP
+
+#include <string>
+
+#include <oocmd/autotuner.hpp>
+#include <oocmd/config_object.hpp>
+#include <oocmd/result_sink.hpp>
+#include <oocmd/util/arena.hpp>
+#include <oocmd/util/process_setup.hpp>
+
+namespace oocmd {
+
+/**
+ * \brief Standard options provided by every \ref Application
+ *
+ * The options are declared as sub parameters of the \c oocmd object parameter of the application, e.g., <tt>--oocmd.threads=8</tt>.
+ */
+class Options : public ConfigObject {
+public:
+    unsigned int threads = 0;
+    CpuSet       pin;
+    Placement    placement = Placement::compact;
+
+    bool         mlock = false;
+    HugePages    thp = HugePages::inherit;
+    SchedPolicy  sched;
+    int          nice = 0;
+    std::string  coredump_filter;
+    size_t       prefault = 0;
+
+    bool         sweep = false;
+    unsigned int jobs = 1;
+    std::string  sweep_output;
+
+    std::string  batch;
+    unsigned int parallel = 0;
+    std::string  batch_output;
+
+    unsigned int repeat = 0;
+    unsigned int warmup = 0;
+
+    bool         profile = false;
+    bool         perf = false;
+    std::string  trace;
+
+    std::string  results;
+    ResultFormat result_format = ResultFormat::result;
+
+    std::string  control;
+
+    std::string    config;
+    unsigned int   tune = 0;
+    TuningStrategy tune_strategy = TuningStrategy::coordinate;
+    std::string    tune_objective;
+    bool           tune_maximize = false;
+    unsigned int   tune_seed = 0;
+    std::string    tune_output;
+
+    inline Options() : ConfigObject("Options", "Standard options provided by oocmd") {
+        param("threads", threads, "The number of worker threads in the application's thread pool (0 for all available cores).");
+        param("pin", pin, "The CPUs to pin the workers of the application's thread pool to.");
+        param("placement", placement, "How to place the workers of the application's thread pool on the pinned CPUs.");
+
+        param("mlock", mlock, "Locks all current and future memory pages of the process into memory.");
+        param("thp", thp, "The transparent huge page mode of the process.");
+        param("sched", sched, "The scheduling policy of the process, e.g., batch or fifo:10.");
+        param("nice", nice, "The value to add to the nice value of the process.");
+        param("coredump_filter", coredump_filter, "The core dump filter of the process as a hexadecimal bit mask.");
+        param("prefault", prefault, "The amount of heap memory to pre-fault.");
+
+        param("sweep", sweep, "Runs the program for each combination of the values assigned to parameters, e.g., --block=64,128 --block-count=1,2.");
+        param("jobs", jobs, "The number of sweep runs to execute concurrently (0 for all available cores), ignored when benchmarking.");
+        param("sweep_output", sweep_output, "The file to write the configuration and return code of each sweep run to (standard output if empty).");
+
+        param("batch", batch, "Runs the program once for each command line in the given job file (- for the standard input).");
+        param("parallel", parallel, "The number of batch jobs to execute concurrently (0 for all available cores).");
+        param("batch_output", batch_output, "The file to write the configuration, return code and output of each batch job to (standard output if empty).");
+
+        param("repeat", repeat, "Benchmarks the program by running it the given number of times and reporting resource usage statistics.");
+        param("warmup", warmup, "The number of unmeasured runs to execute before benchmarking.");
+
+        param("control", control, "The path of a Unix domain socket to serve for inspecting the configuration and assigning live parameters while running.");
+
+        param("profile", profile, "Enables the phase profiler and prints the aggregated phase tree to the standard error after running.");
+        param("perf", perf, "Records hardware performance counters for each profiled phase, if available.");
+        param("trace", trace, "The file to write a Chrome trace of the profiled phases to; enables the phase profiler.");
+
+        param("results", results, "The file to append result lines to (standard output if empty).");
+        param("result_format", result_format, "The format of result lines.");
+
+        param("config", config, "A JSON configuration file to load, e.g., as written by autotuning; parameters given on the command line take precedence.");
+        param("tune", tune, "Autotunes the tunable parameters using at most the given number of runs.");
+        param("tune_strategy", tune_strategy, "The search strategy for autotuning.");
+        param("tune_objective", tune_objective, "The recorded measurement to minimize when autotuning (the wall-clock time of a run if empty).");
+        param("tune_maximize", tune_maximize, "Maximizes the objective instead of minimizing it when autotuning.");
+        param("tune_seed", tune_seed, "The seed for random decisions when autotuning.");
+        param("tune_output", tune_output, "The file to write the best configuration found by autotuning to (standard output if empty).");
+    }
+
+    /**
+     * \brief Applies the process-level setup to the current process
+     *
+     * Huge pages and scheduling are configured first, then memory is pre-faulted and finally locked.
+     *
+     * \param errors receives error messages for all settings that could not be applied
+     * \return true if all settings were applied
+     * \return false otherwise
+     */
+    inline bool apply(ErrorList& errors) const {
+        auto const num_errors = errors.size();
+        auto check = [&](bool const success, std::string const& error) {
+            if(!success) errors.emplace_back(error);
+        };
+
+        std::string error;
+        check(process::set_huge_pages(thp, error), error);
+        check(process::set_sched_policy(sched, error), error);
+        check(process::adjust_nice(nice, error), error);
+        check(process::set_coredump_filter(coredump_filter, error), error);
+        check(process::prefault(prefault, thp == HugePages::always || thp == HugePages::madvise, error), error);
+        if(mlock) check(process::lock_memory(error), error);
+        return errors.size() == num_errors;
+    }
+};
+
+}
+
+#endif
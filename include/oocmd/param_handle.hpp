@@ -0,0 +1,99 @@
+#ifndef _OOCMD_PARAM_HANDLE_HPP
+#define _OOCMD_PARAM_HANDLE_HPP
+
+#include <cassert>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+
+#include <oocmd/choice.hpp>
+#include <oocmd/config_object.hpp>
+#include <oocmd/util/resolve_param.hpp>
+
+namespace oocmd {
+
+/**
+ * \brief A typed reference to the value of a parameter, resolved once by \ref ConfigObject::handle
+ *
+ * Reading the value does not involve any lookups, string operations or JSON.
+ *
+ * \tparam T the type of the value
+ */
+template<typename T>
+class ParamHandle {
+private:
+    T const* value_;
+
+public:
+    /**
+     * \brief Constructs an invalid handle
+     */
+    inline ParamHandle() : value_(nullptr) {
+    }
+
+    /**
+     * \brief Constructs a handle to the given value
+     *
+     * \param value the value
+     */
+    inline explicit ParamHandle(T const& value) : value_(&value) {
+    }
+
+    /**
+     * \brief Tests whether the handle refers to a value
+     *
+     * \return true if the handle was resolved successfully
+     * \return false otherwise
+     */
+    inline bool valid() const { return value_ != nullptr; }
+
+    /**
+     * \brief Equivalent to \ref valid
+     */
+    explicit inline operator bool() const { return valid(); }
+
+    /**
+     * \brief Provides access to the value, which requires the handle to be \ref valid
+     *
+     * \return a reference to the value
+     */
+    inline T const& get() const {
+        assert(value_);
+        return *value_;
+    }
+
+    inline T const& operator*() const { return get(); }
+    inline T const* operator->() const { return &get(); }
+};
+
+template<typename T>
+inline ParamHandle<T> ConfigObject::handle(std::string_view const path, std::string* error) {
+    auto fail = [&](std::string_view const what) {
+        if(error) error->assign(what).append(": ").append(path);
+        return ParamHandle<T>();
+    };
+
+    ConfigObject* owner;
+    auto const* param = resolve_param(*this, path, owner);
+    if(!param) return fail("unknown parameter");
+
+    if constexpr(DerivedFromConfigObject<T>) {
+        ConfigObject const* object = nullptr;
+        if(auto const* oparam = dynamic_cast<ObjectParam const*>(param)) {
+            object = &oparam->object(*owner);
+        } else if(auto const* cparam = dynamic_cast<ChoiceParam const*>(param)) {
+            object = &cparam->object(*owner);
+        }
+
+        auto const* x = dynamic_cast<T const*>(object);
+        if(!x) return fail("parameter is not an object of the requested type");
+        return ParamHandle<T>(*x);
+    } else {
+        if(param->bound_type() != typeid(T)) return fail("parameter is not of the requested type");
+        return ParamHandle<T>(*static_cast<T const*>(param->bound(*owner)));
+    }
+}
+
+}
+
+#endif
@@ -2,8 +2,10 @@
 #define _OOCMD_BYTES_PARAM_HPP
 
 #include <cstdint>
+#include <string>
 
 #include <oocmd/params/value_param.hpp>
+#include <oocmd/util/machine.hpp>
 #include <oocmd/util/si_iec_string.hpp>
 
 namespace oocmd {
@@ -12,16 +14,23 @@ class BytesParam : public ValueParam<uintmax_t> {
 public:
     using ValueParam::ValueParam;
 
-    inline bool configure(nlohmann::json const& json) const override {
-        if(json.contains(name_)) {
-            auto const& v = json[name_];
+    inline bool configure(ConfigObject& owner, nlohmann::json const& json) const override {
+        if(json.contains(name())) {
+            auto const& v = json[name()];
             if(v.is_number()) {
-                *ref_ = v.get<uint64_t>();
+                ref(owner) = v.get<uint64_t>();
+                annotate(owner, *this, {});
                 return true;
             } else if(v.is_string()) {
+                auto const& s = v.get_ref<std::string const&>();
                 uint64_t parse_result;
-                if(parse_si_iec_string(v.get<std::string>(), parse_result)) {
-                    *ref_ = parse_result;
+                if(parse_si_iec_string(s, parse_result)) {
+                    ref(owner) = parse_result;
+                    annotate(owner, *this, {});
+                    return true;
+                } else if(machine::resolve_memory_expression(s, parse_result)) {
+                    ref(owner) = parse_result;
+                    annotate(owner, *this, machine::strip_annotation(s)); // the machine-dependent expression that the value was resolved from
                     return true;
                 }
             }
@@ -29,11 +38,24 @@ public:
         return false;
     }
 
-    inline  void read_config(nlohmann::json& dst) const override {
-        dst[name_] = *ref_; // TODO: format using SI IEC
+    inline bool assign(ConfigObject& owner, std::string_view const value, bool const append) const override {
+        if(parse_number(value, ref(owner))) {
+            annotate(owner, *this, {});
+            return true;
+        }
+        return ConfigParam::assign(owner, value, append);
+    }
+
+    inline void read_config(ConfigObject const& owner, nlohmann::json& dst) const override {
+        auto const expression = annotation(owner, *this);
+        if(expression.empty()) {
+            dst[name()] = ref(owner); // TODO: format using SI IEC
+        } else {
+            dst[name()] = machine::annotate_expression(expression, ref(owner));
+        }
     }
 
-    inline std::string value_type_str() const override { return "non-negative SI/IEC integer"; }
+    inline std::string value_type_str() const override { return "non-negative SI/IEC integer, or [PERCENT%]ram|cgroup-limit|L1|L2|L3"; }
     inline std::string default_value_str() const override { return make_si_iec_string(default_value_); }
 };
 
@@ -10,8 +10,12 @@ class DoubleParam : public ValueParam<double> {
 public:
     using ValueParam::ValueParam;
 
-    inline bool configure(nlohmann::json const& json) const override { return ValueParam::configure_number(json, name_, ref_, [](std::string const& s){ return std::stod(s); }); }
-    inline void read_config(nlohmann::json& dst) const override { dst[name_] = *ref_; }
+    inline bool configure(ConfigObject& owner, nlohmann::json const& json) const override { return ValueParam::configure_number(json, name(), ref(owner), [](std::string const& s){ return std::stod(s); }); }
+    inline void read_config(ConfigObject const& owner, nlohmann::json& dst) const override { dst[name()] = ref(owner); }
+
+    inline bool assign(ConfigObject& owner, std::string_view const value, bool const append) const override {
+        return parse_number(value, ref(owner)) || ConfigParam::assign(owner, value, append);
+    }
     inline std::string value_type_str() const override { return "double"; }
 
     inline std::string default_value_str() const override {
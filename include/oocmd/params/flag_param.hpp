@@ -10,21 +10,26 @@ class FlagParam : public ValueParam<bool> {
 public:
     using ValueParam::ValueParam;
 
-    inline bool configure(nlohmann::json const& json) const override {
-        if(json.contains(name_)) {
-            auto const& v = json[name_];
+    inline bool configure(ConfigObject& owner, nlohmann::json const& json) const override {
+        if(json.contains(name())) {
+            auto const& v = json[name()];
             if(v.is_boolean()) {
-                *ref_ = v.get<bool>();
+                ref(owner) = v.get<bool>();
                 return true;
             } else if(v.is_string()) {
-                *ref_ = string_contains_true(v.get<std::string>());
+                ref(owner) = string_contains_true(v.get<std::string>());
                 return true;
             }
         }
         return false;
     }
 
-    inline void read_config(nlohmann::json& dst) const override { dst[name_] = *ref_; }
+    inline bool assign(ConfigObject& owner, std::string_view const value, bool) const override {
+        ref(owner) = string_contains_true(value);
+        return true;
+    }
+
+    inline void read_config(ConfigObject const& owner, nlohmann::json& dst) const override { dst[name()] = ref(owner); }
     inline bool is_flag() const override { return true; }
     inline std::string value_type_str() const override { return "flag"; }
     inline std::string default_value_str() const override { return default_value_ ? "on" : "off"; }
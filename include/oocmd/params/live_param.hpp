@@ -0,0 +1,132 @@
+#ifndef _OOCMD_LIVE_PARAM_HPP
+#define _OOCMD_LIVE_PARAM_HPP
+
+#include <atomic>
+#include <charconv>
+#include <concepts>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include <oocmd/config_param.hpp>
+#include <oocmd/util/bool_string.hpp>
+#include <oocmd/util/value_traits.hpp>
+
+namespace oocmd {
+
+/**
+ * \brief Requires a type to be usable as the value of a live parameter, i.e., a lock-free atomic flag, number or type with \ref value_traits
+ *
+ * \tparam T the value type
+ */
+template<typename T>
+concept LiveValue = std::atomic<T>::is_always_lock_free && (std::same_as<T, bool> || std::floating_point<T> || HasValueTraits<T>);
+
+// parameter bound to an atomic member, which may be assigned while other threads are reading it, e.g., via the control socket of an application
+template<LiveValue T>
+class LiveParam : public ConfigParam {
+private:
+    ptrdiff_t offset_; // the offset of the bound member within the owning object
+    T         default_value_;
+
+    inline std::atomic<T>& ref(ConfigObject& owner) const { return member<std::atomic<T>>(owner, offset_); }
+    inline std::atomic<T> const& ref(ConfigObject const& owner) const { return member<std::atomic<T>>(owner, offset_); }
+
+    static bool parse(std::string_view const s, T& out_v) {
+        if constexpr(std::same_as<T, bool>) {
+            out_v = string_contains_true(s);
+            return out_v || string_contains_false(s);
+        } else if constexpr(std::floating_point<T>) {
+            auto const [end, ec] = std::from_chars(s.data(), s.data() + s.size(), out_v);
+            return ec == std::errc() && end == s.data() + s.size();
+        } else {
+            return value_traits<T>::parse(s, out_v);
+        }
+    }
+
+    static nlohmann::json to_json(T const v) {
+        if constexpr(std::same_as<T, bool> || std::floating_point<T>) {
+            return v;
+        } else {
+            return value_to_json(v);
+        }
+    }
+
+public:
+    inline LiveParam(ConfigObject const& owner, const char short_name, std::string_view name, std::atomic<T>& ref, std::string_view desc)
+        : ConfigParam(short_name, name, desc), offset_(offset_of(owner, &ref)), default_value_(ref.load(std::memory_order_relaxed)) {
+    }
+
+    inline bool is_flag() const override { return std::same_as<T, bool>; }
+    inline bool is_list() const override { return false; }
+    inline bool is_live() const override { return true; }
+
+    inline bool configure(ConfigObject& owner, nlohmann::json const& json) const override {
+        if(json.contains(name())) {
+            auto const& v = json[name()];
+            if(v.is_string()) {
+                return assign(owner, v.get_ref<std::string const&>(), false);
+            } else if(std::same_as<T, bool> ? v.is_boolean() : (std::is_arithmetic_v<T> && v.is_number())) {
+                if constexpr(std::is_arithmetic_v<T>) {
+                    ref(owner).store(v.get<T>(), std::memory_order_relaxed);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    inline bool assign(ConfigObject& owner, std::string_view const value, bool) const override {
+        T v;
+        if(!parse(value, v)) return false;
+        ref(owner).store(v, std::memory_order_relaxed);
+        return true;
+    }
+
+    inline bool accepts_as_string(std::string_view const value) const override {
+        T v;
+        return parse(value, v) && to_json(v).is_string();
+    }
+
+    inline void read_config(ConfigObject const& owner, nlohmann::json& dst) const override { dst[name()] = to_json(ref(owner).load(std::memory_order_relaxed)); }
+    inline void reset(ConfigObject& owner) const override { ref(owner).store(default_value_, std::memory_order_relaxed); }
+
+    inline bool has_default_value(ConfigObject const& owner) const override {
+        if constexpr(std::equality_comparable<T>) {
+            return ref(owner).load(std::memory_order_relaxed) == default_value_;
+        } else {
+            return false;
+        }
+    }
+
+    inline ptrdiff_t offset() const override { return offset_; }
+
+    inline std::type_info const& bound_type() const override { return typeid(std::atomic<T>); }
+    inline void const* bound(ConfigObject const& owner) const override { return &ref(owner); }
+
+    inline std::string value_type_str() const override {
+        if constexpr(std::same_as<T, bool>) {
+            return "flag";
+        } else if constexpr(std::floating_point<T>) {
+            return std::same_as<T, float> ? "float" : "double";
+        } else {
+            return value_traits<T>::type_name();
+        }
+    }
+
+    inline std::string default_value_str() const override {
+        if constexpr(std::same_as<T, bool>) {
+            return default_value_ ? "on" : "off";
+        } else if constexpr(std::floating_point<T>) {
+            std::ostringstream s;
+            s << default_value_;
+            return s.str();
+        } else {
+            return value_traits<T>::format(default_value_);
+        }
+    }
+};
+
+}
+
+#endif
@@ -12,11 +12,11 @@ class StringListParam : public ValueParam<std::vector<std::string>> {
 public:
     using ValueParam::ValueParam;
 
-    inline bool configure(nlohmann::json const& json) const override {
-        if(json.contains(name_)) {
+    inline bool configure(ConfigObject& owner, nlohmann::json const& json) const override {
+        if(json.contains(name())) {
             std::vector<std::string> list;
 
-            auto const& a = json[name_];
+            auto const& a = json[name()];
             if(a.is_array()) {
                 list.reserve(a.size());
                 for(auto const& e : a.items()) {                    
@@ -29,21 +29,28 @@ public:
                     }
                 }
 
-                *ref_ = std::move(list);
+                ref(owner) = std::move(list);
                 return true;
             } else if(a.is_string()) {
                 // a single string is interpreted as a list of size 1
                 list.reserve(1);
                 list.push_back(a.get<std::string>());
-                *ref_ = std::move(list);
+                ref(owner) = std::move(list);
                 return true;
             }
         }
         return false;
     }
 
+    inline bool assign(ConfigObject& owner, std::string_view const value, bool const append) const override {
+        auto& list = ref(owner);
+        if(!append) list.clear();
+        list.emplace_back(value);
+        return true;
+    }
+
     inline bool is_list() const override { return true; }
-    inline void read_config(nlohmann::json& dst) const override { dst[name_] = *ref_; }
+    inline void read_config(ConfigObject const& owner, nlohmann::json& dst) const override { dst[name()] = ref(owner); }
     inline std::string value_type_str() const override { return "array of strings"; }
     inline std::string default_value_str() const override { return default_value_.empty() ? "none" : ("[" + std::to_string(default_value_.size()) + "]"); }
 };
@@ -11,18 +11,25 @@ class StringParam : public ValueParam<std::string> {
 public:
     using ValueParam::ValueParam;
     
-    inline bool configure(nlohmann::json const& json) const override {
-        if(json.contains(name_)) {
-            auto const& v = json[name_];
+    inline bool configure(ConfigObject& owner, nlohmann::json const& json) const override {
+        if(json.contains(name())) {
+            auto const& v = json[name()];
             if(v.is_string()) {
-                *ref_ = v.get<std::string>();
+                ref(owner) = v.get<std::string>();
                 return true;
             }
         }
         return false;
     }
 
-    inline void read_config(nlohmann::json& dst) const override { dst[name_] = *ref_; }
+    inline bool assign(ConfigObject& owner, std::string_view const value, bool) const override {
+        ref(owner) = value;
+        return true;
+    }
+
+    inline bool accepts_as_string(std::string_view) const override { return true; }
+
+    inline void read_config(ConfigObject const& owner, nlohmann::json& dst) const override { dst[name()] = ref(owner); }
     inline std::string value_type_str() const override { return "string"; }
     inline std::string default_value_str() const override { return std::string(default_value_); }
 };
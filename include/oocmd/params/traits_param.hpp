@@ -0,0 +1,49 @@
+#ifndef _OOCMD_TRAITS_PARAM_HPP
+#define _OOCMD_TRAITS_PARAM_HPP
+
+#include <string>
+
+#include <oocmd/params/value_param.hpp>
+#include <oocmd/util/value_traits.hpp>
+
+namespace oocmd {
+
+template<HasValueTraits T>
+class TraitsParam : public ValueParam<T> {
+private:
+    using ValueParam<T>::default_value_;
+    using ValueParam<T>::name;
+    using ValueParam<T>::ref;
+
+    using Traits = value_traits<T>;
+
+public:
+    using ValueParam<T>::ValueParam;
+
+    inline bool configure(ConfigObject& owner, nlohmann::json const& json) const override {
+        if(json.contains(name())) {
+            auto const& v = json[name()];
+            if(v.is_string()) {
+                return Traits::parse(v.template get_ref<std::string const&>(), ref(owner));
+            } else if(v.is_number() || v.is_boolean()) {
+                return Traits::parse(v.dump(), ref(owner));
+            }
+        }
+        return false;
+    }
+
+    inline bool assign(ConfigObject& owner, std::string_view const value, bool) const override { return Traits::parse(value, ref(owner)); }
+
+    inline bool accepts_as_string(std::string_view const value) const override {
+        T v;
+        return Traits::parse(value, v) && value_to_json(v).is_string();
+    }
+
+    inline void read_config(ConfigObject const& owner, nlohmann::json& dst) const override { dst[name()] = value_to_json(ref(owner)); }
+    inline std::string value_type_str() const override { return Traits::type_name(); }
+    inline std::string default_value_str() const override { return Traits::format(default_value_); }
+};
+
+}
+
+#endif
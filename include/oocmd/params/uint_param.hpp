@@ -1,7 +1,10 @@
 #ifndef _OOCMD_UINT_PARAM_HPP
 #define _OOCMD_UINT_PARAM_HPP
 
+#include <string>
+
 #include <oocmd/params/value_param.hpp>
+#include <oocmd/util/machine.hpp>
 
 namespace oocmd {
 
@@ -9,9 +12,43 @@ class UIntParam : public ValueParam<unsigned int> {
 public:
     using ValueParam::ValueParam;
 
-    inline bool configure(nlohmann::json const& json) const override { return ValueParam::configure_number(json, name_, ref_, [](std::string const& s){ return std::stoul(s); }); }
-    inline void read_config(nlohmann::json& dst) const override { dst[name_] = *ref_; }
-    inline std::string value_type_str() const override { return "non-negative integer"; }
+    inline bool configure(ConfigObject& owner, nlohmann::json const& json) const override {
+        if(json.contains(name())) {
+            auto const& v = json[name()];
+            unsigned int resolved;
+            if(v.is_string() && machine::resolve_cores_expression(v.get_ref<std::string const&>(), resolved)) {
+                ref(owner) = resolved;
+                annotate(owner, *this, machine::strip_annotation(v.get_ref<std::string const&>())); // the machine-dependent expression that the value was resolved from
+                return true;
+            }
+        }
+
+        if(ValueParam::configure_number(json, name(), ref(owner), [](std::string const& s){ return std::stoul(s); })) {
+            annotate(owner, *this, {});
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    inline bool assign(ConfigObject& owner, std::string_view const value, bool const append) const override {
+        if(parse_number(value, ref(owner))) {
+            annotate(owner, *this, {});
+            return true;
+        }
+        return ConfigParam::assign(owner, value, append);
+    }
+
+    inline void read_config(ConfigObject const& owner, nlohmann::json& dst) const override {
+        auto const expression = annotation(owner, *this);
+        if(expression.empty()) {
+            dst[name()] = ref(owner);
+        } else {
+            dst[name()] = machine::annotate_expression(expression, ref(owner));
+        }
+    }
+
+    inline std::string value_type_str() const override { return "non-negative integer, or auto|cores|cores/N|cores*N"; }
     inline std::string default_value_str() const override { return std::to_string(default_value_); }
 };
 
@@ -1,7 +1,9 @@
 #ifndef _OOCMD_VALUE_PARAM_HPP
 #define _OOCMD_VALUE_PARAM_HPP
 
+#include <charconv>
 #include <concepts>
+#include <string_view>
 
 #include <oocmd/config_param.hpp>
 
@@ -11,32 +13,42 @@ template<std::semiregular T>
 class ValueParam : public ConfigParam {
 protected:
     template<typename Parser>
-    static bool configure_number(nlohmann::json const& json, std::string const& name, T* ref, Parser parse) {
+    static bool configure_number(nlohmann::json const& json, std::string const& name, T& ref, Parser parse) {
         if(json.contains(name)) {
             auto const& v = json[name];
             if(v.is_string()) {
                 try {
-                    *ref = parse(v.get<std::string>());
+                    ref = parse(v.get<std::string>());
                     return true;
                 } catch(std::invalid_argument const&) {
                 } catch(std::out_of_range const&) {
                 }
             } else if(v.is_number()) {
-                *ref = v.get<T>();
+                ref = v.get<T>();
                 return true;
             }
         }
         return false;
     }
 
-    T* ref_;
-    T  default_value_;
+    // parses a plain number without building JSON, the entire string being consumed
+    static bool parse_number(std::string_view const s, T& out_v) {
+        auto const [end, ec] = std::from_chars(s.data(), s.data() + s.size(), out_v);
+        return ec == std::errc() && end == s.data() + s.size();
+    }
+
+    ptrdiff_t offset_; // the offset of the bound member within the owning object
+    T         default_value_;
+
+    inline T& ref(ConfigObject& owner) const { return member<T>(owner, offset_); }
+    inline T const& ref(ConfigObject const& owner) const { return member<T>(owner, offset_); }
 
 public:
-    inline ValueParam() : ref_(nullptr) {
+    inline ValueParam() : offset_(0) {
     }
 
-    inline ValueParam(const char short_name, std::string&& name, T& ref, std::string&& desc) : ConfigParam(short_name, std::move(name), std::move(desc)), ref_(&ref) {
+    inline ValueParam(ConfigObject const& owner, const char short_name, std::string_view name, T& ref, std::string_view desc)
+        : ConfigParam(short_name, name, desc), offset_(offset_of(owner, &ref)) {
         default_value_ = ref;
     }
 
@@ -45,6 +57,21 @@ public:
     ValueParam(ValueParam&&) = default;
     ValueParam& operator=(ValueParam&&) = default;
 
+    inline void reset(ConfigObject& owner) const override { ref(owner) = default_value_; }
+
+    inline bool has_default_value(ConfigObject const& owner) const override {
+        if constexpr(std::equality_comparable<T>) {
+            return ref(owner) == default_value_;
+        } else {
+            return false;
+        }
+    }
+
+    inline ptrdiff_t offset() const override { return offset_; }
+
+    inline std::type_info const& bound_type() const override { return typeid(T); }
+    inline void const* bound(ConfigObject const& owner) const override { return &ref(owner); }
+
     inline virtual bool is_flag() const override { return false; }
     inline virtual bool is_list() const override { return false; }
 };
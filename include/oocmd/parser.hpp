@@ -0,0 +1,232 @@
+#ifndef _OOCMD_PARSER_HPP
+#define _OOCMD_PARSER_HPP
+
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <oocmd/choice.hpp>
+#include <oocmd/config_object.hpp>
+#include <oocmd/util/resolve_param.hpp>
+#include <oocmd/util/tokenize.hpp>
+
+namespace oocmd {
+
+/**
+ * \brief A reusable parser that configures an object from many command lines
+ *
+ * Unlike an \ref Application , which parses a single command line, a parser is bound to an object once and can then parse any number of command lines into it,
+ * e.g., job specifications received by a dispatcher.
+ * Each parse first \ref ConfigObject::reset "resets" the object to its defaults (or a \ref baseline configuration) and then assigns the parameters given in the command line,
+ * resolving them directly against the object's schema rather than building a JSON configuration first.
+ * Internal buffers are reused across parses, so that parsing a command line typically does not allocate any memory.
+ *
+ * The command line syntax is that of an \ref Application , with the following restrictions:
+ * - the type name of a \ref Choice must be assigned before any of the chosen object's parameters, and
+ * - values that cannot be parsed are reported as errors rather than ignored.
+ *
+ * Standard options (i.e., <tt>--oocmd.*</tt>) and usage information are not supported.
+ *
+ * A parser is not thread-safe, but since the schema is shared read-only, one parser per thread may be used concurrently, each bound to a different object.
+ */
+class Parser {
+private:
+    ConfigObject* target_;
+    nlohmann::json const* baseline_ = nullptr; // the configuration that each parse starts from, if any
+
+    std::vector<std::string_view> tokens_; // the tokens of the current command line
+    std::string buffer_;                   // unquoted tokens of the current command line
+    std::vector<std::string_view> args_;   // the free arguments of the current command line
+    std::vector<std::string> errors_;      // errors that occurred during the current parse
+
+    // the list parameters that have been assigned during the current parse, so that further values are appended
+    std::vector<std::pair<ConfigObject const*, ConfigParam const*>> lists_;
+
+    void error(std::string_view const what, std::string_view const token) {
+        std::string msg;
+        msg.append(what).append(" \"").append(token).append("\"");
+        errors_.push_back(std::move(msg));
+    }
+
+    // assigns a value to a parameter of the given object
+    void assign(ConfigObject& owner, ConfigParam const& param, std::string_view const value, std::string_view const token) {
+        bool append = false;
+        if(param.is_list()) {
+            auto const key = std::make_pair(static_cast<ConfigObject const*>(&owner), &param);
+            for(auto const& l : lists_) {
+                if(l == key) {
+                    append = true;
+                    break;
+                }
+            }
+            if(!append) lists_.push_back(key);
+        }
+
+        if(!param.assign(owner, value, append)) error("invalid value assigned in argument", token);
+    }
+
+    bool parse_tokens(std::span<std::string_view const> const tokens) {
+        target_->reset();
+        if(baseline_) target_->configure(*baseline_);
+        args_.clear();
+        errors_.clear();
+        lists_.clear();
+
+        // the parameter awaiting a value from the next argument, if any
+        ConfigObject* pending_owner = nullptr;
+        ConfigParam const* pending = nullptr;
+        std::string_view pending_token;
+
+        for(auto const token : tokens) {
+            if(token.size() > 1 && token[0] == '-') {
+                if(pending) error("no value given in argument", pending_token);
+                pending = nullptr;
+
+                if(token[1] == '-') {
+                    // long parameter, possibly with an assignment
+                    auto path = token.substr(2);
+                    auto const eq = path.find('=');
+                    auto const has_value = eq != std::string_view::npos;
+                    auto const value = has_value ? path.substr(eq + 1) : std::string_view();
+                    if(has_value) path = path.substr(0, eq);
+
+                    ConfigObject* owner;
+                    auto const* param = resolve_param(*target_, path, owner);
+                    if(!param) {
+                        error("unknown configuration parameter in argument", token);
+                    } else if(has_value) {
+                        assign(*owner, *param, value, token);
+                    } else if(param->is_flag()) {
+                        assign(*owner, *param, "true", token);
+                    } else {
+                        pending_owner = owner;
+                        pending = param;
+                        pending_token = token;
+                    }
+                } else {
+                    // short parameters, the last of which may take a value from the next argument
+                    for(auto const c : token.substr(1)) {
+                        if(pending) error("no value given in argument", pending_token);
+                        pending = nullptr;
+
+                        auto const* param = target_->get_param(c);
+                        if(!param) {
+                            error("unknown configuration parameter in argument", token);
+                        } else if(param->is_flag()) {
+                            assign(*target_, *param, "true", token);
+                        } else {
+                            pending_owner = target_;
+                            pending = param;
+                            pending_token = token;
+                        }
+                    }
+                }
+            } else if(pending) {
+                assign(*pending_owner, *pending, token, pending_token);
+                pending = nullptr;
+            } else {
+                args_.push_back(token);
+            }
+        }
+
+        if(pending) error("no value given in argument", pending_token);
+        return errors_.empty();
+    }
+
+public:
+    /**
+     * \brief Binds a parser to an object
+     *
+     * \param target the object to configure, which must outlive the parser
+     */
+    inline Parser(ConfigObject& target) : target_(&target) {
+        target.schema(); // make sure the schema is complete before parsing
+    }
+
+    /**
+     * \brief Sets a configuration that each parse starts from, e.g., parameters shared by all command lines
+     *
+     * After resetting the object to its defaults, each parse configures it from the given configuration before assigning the parameters given in the command line.
+     *
+     * \param config the configuration, which must remain valid while the parser is in use, or \c nullptr to start from the defaults
+     */
+    inline void baseline(nlohmann::json const* config) {
+        baseline_ = config;
+    }
+
+    /**
+     * \brief Parses a command line given as arguments to a \c main method
+     *
+     * \param argc the number of arguments
+     * \param argv the arguments, the first of which is the program name and is ignored
+     * \return true if the command line was parsed without errors
+     * \return false otherwise
+     */
+    inline bool parse(int const argc, char const* const* argv) {
+        tokens_.clear();
+        for(int i = 1; i < argc; i++) tokens_.emplace_back(argv[i], std::strlen(argv[i]));
+        return parse_tokens(tokens_);
+    }
+
+    /**
+     * \brief Parses a command line given as a list of arguments
+     *
+     * The arguments must remain valid while the \ref args "free arguments" are in use.
+     *
+     * \param tokens the arguments, not including a program name
+     * \return true if the command line was parsed without errors
+     * \return false otherwise
+     */
+    inline bool parse(std::span<std::string_view const> const tokens) {
+        return parse_tokens(tokens);
+    }
+
+    /**
+     * \brief Parses a shell-quoted command line
+     *
+     * The line is split into arguments as described for \ref tokenize_shell .
+     * The line must remain valid while the \ref args "free arguments" are in use.
+     *
+     * \param line the command line, not including a program name
+     * \return true if the command line was parsed without errors
+     * \return false otherwise
+     */
+    inline bool parse(std::string_view const line) {
+        if(!tokenize_shell(line, tokens_, buffer_)) {
+            target_->reset();
+            args_.clear();
+            errors_.clear();
+            error("unterminated quote or escape in command line", line);
+            return false;
+        }
+        return parse_tokens(tokens_);
+    }
+
+    /**
+     * \brief Provides access to the object that command lines are parsed into
+     *
+     * \return the target object
+     */
+    inline ConfigObject& target() const { return *target_; }
+
+    /**
+     * \brief Provides access to the free arguments of the last parsed command line
+     *
+     * \return the free arguments
+     */
+    inline std::vector<std::string_view> const& args() const { return args_; }
+
+    /**
+     * \brief Provides access to the errors that occurred while parsing the last command line
+     *
+     * \return the errors
+     */
+    inline std::vector<std::string> const& errors() const { return errors_; }
+};
+
+}
+
+#endif
@@ -0,0 +1,439 @@
+#ifndef _OOCMD_PROFILER_HPP
+#define _OOCMD_PROFILER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <nlohmann/json.hpp>
+
+namespace oocmd {
+
+/**
+ * \brief A group of hardware performance counters for the calling thread, backed by \c perf_event_open
+ *
+ * The counters count cycles, instructions, cache misses and branch misses in user mode.
+ */
+class PerfCounters {
+public:
+    static constexpr size_t NUM_COUNTERS = 4;
+    using Values = std::array<uint64_t, NUM_COUNTERS>;
+
+    // the names of the counters, in order
+    static constexpr char const* NAMES[NUM_COUNTERS] = { "cycles", "instructions", "cache_misses", "branch_misses" };
+
+private:
+    std::array<int, NUM_COUNTERS> fds_;
+
+    static int open_counter(uint64_t const config, int const group_fd) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        return int(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+    }
+
+public:
+    /**
+     * \brief Opens the counters for the calling thread
+     *
+     * If any counter cannot be opened, e.g., due to missing permissions or hardware support, the group is not \ref available .
+     */
+    inline PerfCounters() {
+        fds_.fill(-1);
+
+        static constexpr uint64_t CONFIGS[NUM_COUNTERS] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+        for(size_t i = 0; i < NUM_COUNTERS; i++) {
+            fds_[i] = open_counter(CONFIGS[i], i == 0 ? -1 : fds_[0]);
+            if(fds_[i] < 0) {
+                close();
+                return;
+            }
+        }
+    }
+
+    PerfCounters(PerfCounters const&) = delete;
+    PerfCounters& operator=(PerfCounters const&) = delete;
+
+    inline ~PerfCounters() { close(); }
+
+    /**
+     * \brief Closes the counters
+     */
+    inline void close() {
+        for(auto& fd : fds_) {
+            if(fd >= 0) ::close(fd);
+            fd = -1;
+        }
+    }
+
+    /**
+     * \brief Tests whether the counters are available
+     *
+     * \return true if all counters were opened
+     * \return false otherwise
+     */
+    inline bool available() const { return fds_[0] >= 0; }
+
+    /**
+     * \brief Reads the current counter values
+     *
+     * \param out_values receives the counter values
+     * \return true if the counters were read
+     * \return false otherwise
+     */
+    inline bool read(Values& out_values) const {
+        if(!available()) return false;
+
+        uint64_t buf[1 + NUM_COUNTERS];
+        if(::read(fds_[0], buf, sizeof(buf)) != ssize_t(sizeof(buf)) || buf[0] != NUM_COUNTERS) return false;
+        for(size_t i = 0; i < NUM_COUNTERS; i++) out_values[i] = buf[1 + i];
+        return true;
+    }
+};
+
+/**
+ * \brief A hierarchical phase profiler
+ *
+ * Phases are timed using RAII \ref Scope "scopes" returned by \ref phase , which may be nested.
+ * Each thread records its phases into its own buffer, so that recording requires no synchronization after a thread's first phase.
+ * Counters can be attached to the current phase of the calling thread using \ref count .
+ * If enabled, hardware performance counters are additionally recorded for each phase (see \ref PerfCounters ).
+ *
+ * A disabled profiler records nothing, and opening a phase scope amounts to a single branch.
+ *
+ * Phase and counter names are stored as views and must remain valid for the lifetime of the profiler, e.g., by using string literals.
+ *
+ * Typically, the profiler is not constructed directly but obtained from an \ref Application , which configures it using standard parameters.
+ */
+class Profiler {
+private:
+    static constexpr uint32_t NO_EVENT = UINT32_MAX;
+
+    struct Event {
+        std::string_view name;
+        uint64_t begin, end;
+        uint32_t parent;
+        PerfCounters::Values perf_begin, perf;
+        std::vector<std::pair<std::string_view, int64_t>> counters;
+    };
+
+    struct ThreadBuffer {
+        uint32_t tid;
+        std::vector<Event> events;
+        uint32_t current = NO_EVENT;
+        std::unique_ptr<PerfCounters> perf;
+        bool perf_ok = false;
+    };
+
+    struct ThreadSlot {
+        uint64_t profiler_id = 0;
+        ThreadBuffer* buffer = nullptr;
+    };
+
+    static ThreadSlot& thread_slot() {
+        thread_local ThreadSlot slot;
+        return slot;
+    }
+
+    static uint64_t next_id() {
+        static std::atomic<uint64_t> id = 0;
+        return ++id;
+    }
+
+    uint64_t id_;
+    bool enabled_;
+    bool perf_;
+    std::chrono::steady_clock::time_point start_;
+
+    mutable std::mutex mutex_;
+    std::map<std::thread::id, std::unique_ptr<ThreadBuffer>> buffers_;
+
+    uint64_t now() const {
+        return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count());
+    }
+
+    ThreadBuffer& buffer() {
+        auto& slot = thread_slot();
+        if(slot.profiler_id != id_) {
+            std::lock_guard lock(mutex_);
+            auto& buf = buffers_[std::this_thread::get_id()];
+            if(!buf) {
+                buf = std::make_unique<ThreadBuffer>();
+                buf->tid = uint32_t(buffers_.size());
+                if(perf_) {
+                    buf->perf = std::make_unique<PerfCounters>();
+                    buf->perf_ok = buf->perf->available();
+                }
+            }
+            slot = { id_, buf.get() };
+        }
+        return *slot.buffer;
+    }
+
+    // a node of the aggregated phase tree
+    struct Node {
+        uint64_t count = 0;
+        uint64_t total = 0;
+        bool has_perf = false;
+        PerfCounters::Values perf = {};
+        std::map<std::string_view, int64_t> counters;
+        std::vector<std::pair<std::string_view, std::unique_ptr<Node>>> children; // in order of first occurrence
+
+        Node& child(std::string_view const name) {
+            for(auto& [child_name, node] : children) {
+                if(child_name == name) return *node;
+            }
+            return *children.emplace_back(name, std::make_unique<Node>()).second;
+        }
+
+        nlohmann::json to_json(std::string_view const name) const {
+            nlohmann::json j;
+            j["name"] = name;
+            j["count"] = count;
+            j["total_ns"] = total;
+            if(has_perf) {
+                for(size_t i = 0; i < PerfCounters::NUM_COUNTERS; i++) j["perf"][PerfCounters::NAMES[i]] = perf[i];
+            }
+            for(auto const& [counter, value] : counters) j["counters"][std::string(counter)] = value;
+            for(auto const& [child_name, node] : children) j["children"].push_back(node->to_json(child_name));
+            return j;
+        }
+
+        void print(std::ostream& out, std::string_view const name, size_t const depth) const {
+            out << std::string(2 * depth, ' ') << name << ": " << std::fixed << std::setprecision(3) << double(total) * 1e-6 << " ms";
+            if(count > 1) out << " (" << count << "x)";
+            if(has_perf) {
+                for(size_t i = 0; i < PerfCounters::NUM_COUNTERS; i++) out << ", " << PerfCounters::NAMES[i] << "=" << perf[i];
+            }
+            for(auto const& [counter, value] : counters) out << ", " << counter << "=" << value;
+            out << std::endl;
+            for(auto const& [child_name, node] : children) node->print(out, child_name, depth + 1);
+        }
+    };
+
+    Node aggregate() const {
+        Node root;
+        std::lock_guard lock(mutex_);
+        for(auto const& [thread, buf] : buffers_) {
+            // map each event to its node, relying on parents being recorded before their children
+            std::vector<Node*> nodes(buf->events.size());
+            for(size_t i = 0; i < buf->events.size(); i++) {
+                auto const& e = buf->events[i];
+                if(e.end < e.begin) continue; // still open
+                if(e.parent != NO_EVENT && !nodes[e.parent]) continue; // nested in a phase that is still open
+
+                auto& parent = (e.parent == NO_EVENT) ? root : *nodes[e.parent];
+                auto& node = parent.child(e.name);
+                nodes[i] = &node;
+
+                ++node.count;
+                node.total += e.end - e.begin;
+                if(buf->perf_ok) {
+                    node.has_perf = true;
+                    for(size_t k = 0; k < PerfCounters::NUM_COUNTERS; k++) node.perf[k] += e.perf[k];
+                }
+                for(auto const& [counter, value] : e.counters) node.counters[counter] += value;
+            }
+        }
+        return root;
+    }
+
+public:
+    /**
+     * \brief An RAII scope timing a phase
+     *
+     * The phase ends when the scope is destroyed.
+     */
+    class Scope {
+    private:
+        friend class Profiler;
+
+        Profiler* profiler_;
+        ThreadBuffer* buffer_;
+        uint32_t event_;
+
+        inline Scope() : profiler_(nullptr), buffer_(nullptr), event_(NO_EVENT) {
+        }
+
+        inline Scope(Profiler& profiler, ThreadBuffer& buffer, uint32_t const event) : profiler_(&profiler), buffer_(&buffer), event_(event) {
+        }
+
+    public:
+        Scope(Scope const&) = delete;
+        Scope& operator=(Scope const&) = delete;
+
+        inline Scope(Scope&& other) : profiler_(other.profiler_), buffer_(other.buffer_), event_(other.event_) {
+            other.buffer_ = nullptr;
+        }
+
+        Scope& operator=(Scope&&) = delete;
+
+        inline ~Scope() {
+            if(buffer_) {
+                auto& e = buffer_->events[event_];
+                if(buffer_->perf_ok) {
+                    PerfCounters::Values v;
+                    if(buffer_->perf->read(v)) {
+                        for(size_t i = 0; i < PerfCounters::NUM_COUNTERS; i++) e.perf[i] = v[i] - e.perf_begin[i];
+                    }
+                }
+                e.end = profiler_->now();
+                buffer_->current = e.parent;
+            }
+        }
+    };
+
+    /**
+     * \brief Constructs a profiler
+     *
+     * \param enabled whether the profiler records anything
+     * \param perf whether to record hardware performance counters for each phase, if available
+     */
+    inline Profiler(bool const enabled = false, bool const perf = false) : id_(next_id()), enabled_(enabled), perf_(enabled && perf), start_(std::chrono::steady_clock::now()) {
+    }
+
+    Profiler(Profiler const&) = delete;
+    Profiler& operator=(Profiler const&) = delete;
+
+    /**
+     * \brief Tests whether the profiler is enabled
+     *
+     * \return true if the profiler records phases
+     * \return false otherwise
+     */
+    inline bool enabled() const { return enabled_; }
+
+    /**
+     * \brief Begins a phase on the calling thread, nested into the thread's current phase, if any
+     *
+     * \param name the name of the phase, which must remain valid for the lifetime of the profiler
+     * \return a scope that ends the phase when destroyed
+     */
+    [[nodiscard]] inline Scope phase(std::string_view const name) {
+        if(!enabled_) return Scope();
+
+        auto& buf = buffer();
+        auto const index = uint32_t(buf.events.size());
+
+        auto& e = buf.events.emplace_back();
+        e.name = name;
+        e.parent = buf.current;
+        e.perf = {};
+        e.end = 0;
+        buf.current = index;
+
+        if(buf.perf_ok) buf.perf->read(e.perf_begin);
+        e.begin = now();
+        return Scope(*this, buf, index);
+    }
+
+    /**
+     * \brief Adds a value to a counter of the current phase of the calling thread
+     *
+     * If the thread has no current phase, the value is discarded.
+     *
+     * \param name the name of the counter, which must remain valid for the lifetime of the profiler
+     * \param value the value to add
+     */
+    inline void count(std::string_view const name, int64_t const value = 1) {
+        if(!enabled_) return;
+
+        auto& buf = buffer();
+        if(buf.current == NO_EVENT) return;
+
+        auto& counters = buf.events[buf.current].counters;
+        for(auto& [counter, v] : counters) {
+            if(counter == name) {
+                v += value;
+                return;
+            }
+        }
+        counters.emplace_back(name, value);
+    }
+
+    /**
+     * \brief Reports the phases aggregated over all threads as a tree
+     *
+     * Phases with the same name and the same ancestors are aggregated into a single node.
+     * Phases that have not yet ended are ignored along with all phases nested in them, e.g., when the tree is reported from within a phase.
+     * This must not be called while other threads are recording phases.
+     *
+     * \return the aggregated phase tree as JSON, consisting of a list of root phases
+     */
+    inline nlohmann::json tree() const {
+        nlohmann::json j = nlohmann::json::array();
+        auto const root = aggregate();
+        for(auto const& [name, node] : root.children) j.push_back(node->to_json(name));
+        return j;
+    }
+
+    /**
+     * \brief Prints the phases aggregated over all threads as a tree
+     *
+     * \param out the output stream
+     */
+    inline void print_tree(std::ostream& out) const {
+        auto const root = aggregate();
+        for(auto const& [name, node] : root.children) node->print(out, name, 0);
+    }
+
+    /**
+     * \brief Writes all recorded phases in the Chrome trace event format, which can be viewed using Perfetto or \c chrome://tracing
+     *
+     * \param out the output stream
+     * \param config a configuration to embed into the trace's metadata
+     */
+    inline void write_trace(std::ostream& out, nlohmann::json const& config = nlohmann::json()) const {
+        nlohmann::json events = nlohmann::json::array();
+        {
+            std::lock_guard lock(mutex_);
+            for(auto const& [thread, buf] : buffers_) {
+                for(auto const& e : buf->events) {
+                    if(e.end < e.begin) continue; // still open
+
+                    nlohmann::json event = {
+                        { "name", e.name }, { "ph", "X" }, { "pid", 1 }, { "tid", buf->tid },
+                        { "ts", double(e.begin) * 1e-3 }, { "dur", double(e.end - e.begin) * 1e-3 } };
+                    if(buf->perf_ok) {
+                        for(size_t i = 0; i < PerfCounters::NUM_COUNTERS; i++) event["args"][PerfCounters::NAMES[i]] = e.perf[i];
+                    }
+                    for(auto const& [counter, value] : e.counters) event["args"][std::string(counter)] = value;
+                    events.push_back(std::move(event));
+                }
+            }
+        }
+
+        nlohmann::json trace;
+        trace["traceEvents"] = std::move(events);
+        trace["displayTimeUnit"] = "ns";
+        if(!config.is_null()) trace["otherData"]["config"] = config;
+        out << trace.dump() << std::endl;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef _OOCMD_PROVENANCE_HPP
+#define _OOCMD_PROVENANCE_HPP
+
+#include <span>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include <oocmd/choice.hpp>
+#include <oocmd/config_layers.hpp>
+#include <oocmd/config_object.hpp>
+
+namespace oocmd {
+
+inline void ConfigObject::configure(ConfigLayers const& layers) {
+    std::vector<nlohmann::json const*> nodes;
+    nodes.reserve(layers.size());
+    for(size_t i = 0; i < layers.size(); i++) nodes.push_back(&layers.layer(i).config);
+    configure_layered(layers, nodes);
+}
+
+inline void ConfigObject::configure_layered(ConfigLayers const& layers, std::span<nlohmann::json const* const> nodes) {
+    std::vector<nlohmann::json const*> children(nodes.size());
+    for(auto const& it : schema().params()) {
+        auto const& param = *it.second;
+        auto const& name = param.name();
+
+        auto const* oparam = dynamic_cast<ObjectParam const*>(&param);
+        auto const* cparam = oparam ? nullptr : dynamic_cast<ChoiceParam const*>(&param);
+        if(oparam || cparam) {
+            // gather the configurations of the object from all layers, noting the topmost one that selects a type
+            bool any = false;
+            size_t type_layer = ConfigLayers::NONE;
+            for(size_t i = 0; i < nodes.size(); i++) {
+                children[i] = nullptr;
+                if(!nodes[i] || !nodes[i]->is_object()) continue;
+
+                auto const child = nodes[i]->find(name);
+                if(child != nodes[i]->end() && child->is_object() && !child->empty()) {
+                    children[i] = &*child;
+                    any = true;
+                    if(child->contains(TYPE_NAME_KEY)) type_layer = i;
+                }
+            }
+            if(!any) continue;
+
+            if(cparam) {
+                if(type_layer != ConfigLayers::NONE) {
+                    auto const& type_name = (*children[type_layer])[TYPE_NAME_KEY];
+                    nlohmann::json selection;
+                    selection[name][TYPE_NAME_KEY] = type_name;
+                    if(!param.configure(*this, selection)) continue;
+                    set_provenance(param, layers.layer(type_layer).source);
+
+                    // lower layers that select another type configure an alternative that is not used
+                    for(size_t i = 0; i < type_layer; i++) {
+                        if(children[i] && children[i]->contains(TYPE_NAME_KEY) && (*children[i])[TYPE_NAME_KEY] != type_name) children[i] = nullptr;
+                    }
+                }
+                cparam->object(*this).configure_layered(layers, children);
+            } else {
+                oparam->object(*this).configure_layered(layers, children);
+            }
+        } else {
+            // configure the parameter from the topmost layer that assigns it
+            for(size_t i = nodes.size(); i-- > 0;) {
+                if(nodes[i] && nodes[i]->is_object() && nodes[i]->contains(name)) {
+                    if(param.configure(*this, *nodes[i])) set_provenance(param, layers.layer(i).source);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * \brief Reports the provenance of all parameters of an object that were configured from a layer
+ *
+ * \param x the object
+ * \param prefix the prefix for the paths of the parameters
+ * \return an object mapping the dot-separated paths of the parameters to the sources they were configured from
+ */
+inline nlohmann::json provenance_config(ConfigObject const& x, std::string const& prefix = "") {
+    auto result = nlohmann::json::object();
+    for(auto const& it : x.params()) {
+        auto const& param = *it.second;
+        auto const path = prefix + param.name();
+
+        auto const source = x.provenance(param.name());
+        if(!source.empty()) result[path] = source;
+
+        ConfigObject const* sub = nullptr;
+        if(auto const* oparam = dynamic_cast<ObjectParam const*>(&param)) {
+            sub = &oparam->object(x);
+        } else if(auto const* cparam = dynamic_cast<ChoiceParam const*>(&param)) {
+            sub = &cparam->object(x);
+        }
+        if(sub) result.update(provenance_config(*sub, path + "."));
+    }
+    return result;
+}
+
+}
+
+#endif
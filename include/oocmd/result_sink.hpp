@@ -0,0 +1,275 @@
+#ifndef _OOCMD_RESULT_SINK_HPP
+#define _OOCMD_RESULT_SINK_HPP
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <nlohmann/json.hpp>
+#include <oocmd/util/enum_table.hpp>
+
+namespace oocmd {
+
+/**
+ * \brief Formats of result lines written by a \ref ResultSink
+ */
+enum class ResultFormat {
+    result, ///< a line of the form <tt>RESULT key=value ...</tt>
+    jsonl,  ///< a line containing a flat JSON object
+    csv     ///< a CSV line, preceded by a header line if the output is empty; all lines of an output must have the same fields
+};
+
+template<> struct enum_names<ResultFormat> {
+    static constexpr auto table = make_enum_table<ResultFormat>({ { "result", ResultFormat::result }, { "jsonl", ResultFormat::jsonl }, { "csv", ResultFormat::csv } });
+};
+
+/**
+ * \brief Key/value measurements recorded during a run
+ *
+ * Measurements are kept in the order in which they were first recorded.
+ * Recording the same key again overwrites the value.
+ */
+class Measurements {
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::pair<std::string, nlohmann::json>> values_;
+
+public:
+    /**
+     * \brief Records a measurement
+     *
+     * \param key the key
+     * \param value the value, typically a number or a string
+     */
+    inline void record(std::string_view const key, nlohmann::json value) {
+        std::lock_guard lock(mutex_);
+        for(auto& [k, v] : values_) {
+            if(k == key) {
+                v = std::move(value);
+                return;
+            }
+        }
+        values_.emplace_back(key, std::move(value));
+    }
+
+    inline bool empty() const {
+        std::lock_guard lock(mutex_);
+        return values_.empty();
+    }
+
+    /**
+     * \brief Reports the recorded measurements in order
+     *
+     * \return the recorded measurements
+     */
+    inline std::vector<std::pair<std::string, nlohmann::json>> values() const {
+        std::lock_guard lock(mutex_);
+        return values_;
+    }
+};
+
+// flattens a configuration into a list of dot-separated parameter paths and values, lists becoming comma-separated strings
+inline void flatten_config(nlohmann::json const& config, std::string const& prefix, std::vector<std::pair<std::string, nlohmann::json>>& out) {
+    if(config.is_object()) {
+        for(auto const& [key, v] : config.items()) {
+            flatten_config(v, prefix.empty() ? key : prefix + "." + key, out);
+        }
+    } else if(config.is_array()) {
+        std::string list;
+        for(auto const& item : config) {
+            if(!list.empty()) list.push_back(',');
+            list.append(item.is_string() ? item.get<std::string>() : item.dump());
+        }
+        out.emplace_back(prefix, list);
+    } else if(!config.is_null()) {
+        out.emplace_back(prefix, config);
+    }
+}
+
+/**
+ * \brief Writes result lines combining a configuration and measurements
+ *
+ * Each line is assembled in memory and written using a single \c write call on a file opened in append mode, while holding an exclusive \c flock on the file.
+ * Thus, multiple threads or processes may share the same output file.
+ */
+class ResultSink {
+private:
+    ResultFormat format_;
+    std::string path_;
+
+    std::mutex mutex_;
+    std::string header_; // for CSV on the standard output, the header that was written, if any
+
+    static std::string format_value(nlohmann::json const& v) {
+        return v.is_string() ? v.get<std::string>() : v.dump();
+    }
+
+    static std::string csv_field(std::string const& s) {
+        if(s.find_first_of(",\"\n") == std::string::npos) return s;
+
+        std::string quoted = "\"";
+        for(auto const c : s) {
+            if(c == '"') quoted.push_back('"');
+            quoted.push_back(c);
+        }
+        return quoted.append("\"");
+    }
+
+    static std::string csv_header(std::vector<std::pair<std::string, nlohmann::json>> const& fields) {
+        std::string line;
+        for(size_t i = 0; i < fields.size(); i++) line.append(i > 0 ? "," : "").append(csv_field(fields[i].first));
+        return line;
+    }
+
+    // reads the first line of a file, not including the line break
+    static std::string read_first_line(int const fd) {
+        std::string line;
+        char chunk[4096];
+        off_t offset = 0;
+        while(true) {
+            auto const n = ::pread(fd, chunk, sizeof(chunk), offset);
+            if(n <= 0) break;
+
+            std::string_view const s(chunk, size_t(n));
+            auto const end = s.find('\n');
+            line.append(s.substr(0, end));
+            if(end != std::string_view::npos) break;
+            offset += n;
+        }
+        return line;
+    }
+
+    static std::string result_value(std::string const& s) {
+        if(!s.empty() && s.find_first_of(" \t\n\"") == std::string::npos) return s;
+        return nlohmann::json(s).dump();
+    }
+
+public:
+    /**
+     * \brief Constructs a result sink
+     *
+     * \param format the format of result lines
+     * \param path the file to append result lines to, or empty to write them to the standard output
+     */
+    inline ResultSink(ResultFormat const format = ResultFormat::result, std::string path = "") : format_(format), path_(std::move(path)) {
+    }
+
+    ResultSink(ResultSink const&) = delete;
+    ResultSink& operator=(ResultSink const&) = delete;
+
+    /**
+     * \brief Formats a result line
+     *
+     * \param fields the fields, i.e., parameter paths and measurements, in order
+     * \param header if the format is CSV, whether to precede the line by a header line
+     * \return the formatted line, including the trailing newline
+     */
+    inline std::string format_line(std::vector<std::pair<std::string, nlohmann::json>> const& fields, bool const header) const {
+        std::string line;
+        switch(format_) {
+            case ResultFormat::result:
+                line = "RESULT";
+                for(auto const& [key, v] : fields) line.append(" ").append(key).append("=").append(result_value(format_value(v)));
+                break;
+
+            case ResultFormat::jsonl: {
+                nlohmann::json obj = nlohmann::json::object();
+                for(auto const& [key, v] : fields) obj[key] = v;
+                line = obj.dump();
+                break;
+            }
+
+            case ResultFormat::csv:
+                if(header) line.append(csv_header(fields)).append("\n");
+                for(size_t i = 0; i < fields.size(); i++) line.append(i > 0 ? "," : "").append(csv_field(format_value(fields[i].second)));
+                break;
+        }
+        line.push_back('\n');
+        return line;
+    }
+
+    /**
+     * \brief Writes a result line
+     *
+     * The line contains every parameter of the configuration, identified by its dot-separated path, in alphabetical order, followed by the measurements in the order they were recorded.
+     *
+     * In CSV format, the header is only written to an empty output.
+     * A line whose fields differ from those in the existing header, e.g., because a different \ref Choice alternative was selected or different measurements were recorded, is rejected.
+     *
+     * \param config the configuration
+     * \param measurements the measurements
+     * \param error if not null, receives the reason if the line was not written
+     * \return true if the line was written
+     * \return false otherwise
+     */
+    inline bool write(nlohmann::json const& config, Measurements const& measurements, std::string* error = nullptr) {
+        std::vector<std::pair<std::string, nlohmann::json>> fields;
+        flatten_config(config, "", fields);
+        for(auto& m : measurements.values()) fields.push_back(std::move(m));
+
+        auto const csv = format_ == ResultFormat::csv;
+        auto mismatch = [&](std::string const& header){
+            if(error) *error = "fields do not match the CSV header: " + header;
+            return false;
+        };
+        auto failure = [&](std::string_view const what){
+            if(error) *error = std::string(what).append(": ").append(std::strerror(errno));
+            return false;
+        };
+
+        if(path_.empty()) {
+            std::lock_guard lock(mutex_);
+            bool header = false;
+            if(csv) {
+                auto expected = csv_header(fields);
+                if(header_.empty()) {
+                    header_ = std::move(expected);
+                    header = true;
+                } else if(expected != header_) {
+                    return mismatch(header_);
+                }
+            }
+            std::cout << format_line(fields, header) << std::flush;
+            return bool(std::cout);
+        }
+
+        int const fd = ::open(path_.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if(fd < 0) return failure("failed to open");
+
+        bool success = false;
+        if(flock(fd, LOCK_EX) == 0) {
+            // the header is only written to an empty file, otherwise it must match the fields
+            struct stat st;
+            auto const header = csv && fstat(fd, &st) == 0 && st.st_size == 0;
+            std::string existing;
+            if(csv && !header) existing = read_first_line(fd);
+
+            if(csv && !header && existing != csv_header(fields)) {
+                mismatch(existing);
+            } else {
+                auto const line = format_line(fields, header);
+                success = ::write(fd, line.data(), line.size()) == ssize_t(line.size());
+                if(!success) failure("failed to write");
+            }
+            flock(fd, LOCK_UN);
+        } else {
+            failure("failed to lock");
+        }
+        ::close(fd);
+        return success;
+    }
+};
+
+}
+
+#endif
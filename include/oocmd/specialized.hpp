@@ -0,0 +1,128 @@
+#ifndef _OOCMD_SPECIALIZED_HPP
+#define _OOCMD_SPECIALIZED_HPP
+
+#include <concepts>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <oocmd/params/traits_param.hpp>
+
+namespace oocmd {
+
+/**
+ * \brief An integer value for which a list of specializations exists
+ *
+ * Specialized values are configured like plain integers, but can be dispatched to code that is instantiated for each listed value using \ref visit .
+ * This way, configured values such as block sizes or fan-outs can become compile-time constants in the code that uses them,
+ * while values that are not listed are still supported by a generic runtime version.
+ *
+ * As an example, consider a block size that is declared as follows:
+ * \code{.cpp}
+ * Specialized<64U, 128U, 256U, 512U> block_;
+ * \endcode
+ * Calling <tt>block_.visit(f)</tt> will invoke \c f with a <tt>std::integral_constant<unsigned int, 256></tt> if the configured value is 256,
+ * but with a plain <tt>unsigned int</tt> if the configured value is, say, 100.
+ *
+ * By default, the value is the first listed value.
+ *
+ * \tparam V0 the first value with a specialization
+ * \tparam Vs further values with a specialization
+ */
+template<auto V0, decltype(V0)... Vs>
+class Specialized {
+public:
+    using value_type = decltype(V0);
+
+private:
+    static_assert(std::integral<value_type>, "specializations must be integers");
+
+    template<typename F>
+    using result_t = std::invoke_result_t<F, value_type>;
+
+    template<typename F, value_type V, value_type... Rest>
+    inline result_t<F> visit_specialized(F& f) const {
+        if(value_ == V) {
+            return f(std::integral_constant<value_type, V>());
+        } else if constexpr(sizeof...(Rest) > 0) {
+            return visit_specialized<F, Rest...>(f);
+        } else {
+            return f(value_);
+        }
+    }
+
+    value_type value_;
+
+public:
+    // the parameter type used to bind specialized values to config objects
+    class Param : public TraitsParam<value_type> {
+    public:
+        inline Param() {
+        }
+
+        inline Param(ConfigObject const& owner, const char short_name, std::string_view name, Specialized& ref, std::string_view desc)
+            : TraitsParam<value_type>(owner, short_name, name, ref.value_, desc) {
+        }
+
+        inline std::string value_type_str() const override {
+            std::string s = value_traits<value_type>::type_name();
+            s.append(", specialized for ");
+            s.append(std::to_string(V0));
+            ((s.append(", "), s.append(std::to_string(Vs))), ...);
+            return s;
+        }
+    };
+
+    /**
+     * \brief Tests whether a specialization exists for the given value
+     *
+     * \param v the value in question
+     * \return true if the value is listed
+     * \return false otherwise
+     */
+    static constexpr bool has_specialization(value_type v) { return v == V0 || ((v == Vs) || ...); }
+
+    /**
+     * \brief Constructs a value
+     *
+     * \param v the initial value
+     */
+    inline Specialized(value_type v = V0) : value_(v) {
+    }
+
+    inline Specialized& operator=(value_type v) { value_ = v; return *this; }
+
+    /**
+     * \brief Reports the current value
+     *
+     * \return the current value
+     */
+    inline value_type value() const { return value_; }
+
+    inline operator value_type() const { return value_; }
+
+    /**
+     * \brief Tests whether a specialization exists for the current value
+     *
+     * \return true if the current value is listed
+     * \return false otherwise
+     */
+    inline bool specialized() const { return has_specialization(value_); }
+
+    /**
+     * \brief Invokes the given function on the current value
+     *
+     * If the current value is listed, the function is passed a <tt>std::integral_constant</tt> representing it.
+     * Otherwise, the function is passed the value itself.
+     * The results of all instantiations must be convertible to the result of the latter.
+     *
+     * \param f the function to invoke
+     * \return the result of the function
+     */
+    template<typename F>
+    inline result_t<F> visit(F&& f) const { return visit_specialized<F, V0, Vs...>(f); }
+};
+
+}
+
+#endif
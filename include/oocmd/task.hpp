@@ -0,0 +1,173 @@
+#ifndef _OOCMD_TASK_HPP
+#define _OOCMD_TASK_HPP
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace oocmd {
+
+template<typename T = void>
+class Task;
+
+namespace detail {
+
+// the parts of a task's promise that do not depend on its result type
+struct TaskPromiseBase {
+    std::coroutine_handle<> continuation_; // the coroutine awaiting the task, if any
+    std::exception_ptr exception_;
+
+    // resumes the awaiting coroutine, if any, when the task completes
+    struct FinalAwaiter {
+        inline bool await_ready() const noexcept { return false; }
+
+        template<typename Promise>
+        inline std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) const noexcept {
+            auto const continuation = h.promise().continuation_;
+            return continuation ? continuation : std::noop_coroutine();
+        }
+
+        inline void await_resume() const noexcept {}
+    };
+
+    inline std::suspend_always initial_suspend() const noexcept { return {}; }
+    inline FinalAwaiter final_suspend() const noexcept { return {}; }
+    inline void unhandled_exception() { exception_ = std::current_exception(); }
+
+    inline void rethrow() const {
+        if(exception_) std::rethrow_exception(exception_);
+    }
+};
+
+template<typename T>
+struct TaskPromise : public TaskPromiseBase {
+    std::optional<T> result_;
+
+    inline Task<T> get_return_object();
+
+    template<typename U>
+    requires std::convertible_to<U, T>
+    inline void return_value(U&& value) { result_.emplace(std::forward<U>(value)); }
+
+    inline T take() {
+        rethrow();
+        return std::move(*result_);
+    }
+};
+
+template<>
+struct TaskPromise<void> : public TaskPromiseBase {
+    inline Task<void> get_return_object();
+    inline void return_void() {}
+    inline void take() { rethrow(); }
+};
+
+}
+
+/**
+ * \brief A lazily started coroutine that produces a value of the given type
+ *
+ * A task does not start executing until it is awaited via <tt>co_await</tt> or driven by an \ref EventLoop .
+ * When it completes, execution continues directly in the awaiting coroutine.
+ * An exception escaping the task is rethrown to the awaiting coroutine.
+ *
+ * Tasks are returned by asynchronous \c run functions of config objects (see \ref Runnable ), and by the I/O functions of an \ref EventLoop .
+ *
+ * \tparam T the type of the produced value
+ */
+template<typename T>
+class Task {
+public:
+    using value_type = T;
+    using promise_type = detail::TaskPromise<T>;
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+
+public:
+    inline Task() : handle_(nullptr) {
+    }
+
+    inline explicit Task(std::coroutine_handle<promise_type> handle) : handle_(handle) {
+    }
+
+    Task(Task const&) = delete;
+    Task& operator=(Task const&) = delete;
+
+    inline Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {
+    }
+
+    inline Task& operator=(Task&& other) noexcept {
+        if(this != &other) {
+            if(handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    inline ~Task() {
+        if(handle_) handle_.destroy();
+    }
+
+    /**
+     * \brief Tests whether the task has completed
+     *
+     * \return true if the task has completed
+     * \return false if it has not been started or is suspended
+     */
+    inline bool done() const { return !handle_ || handle_.done(); }
+
+    /**
+     * \brief Provides the coroutine handle of the task, e.g., in order to start it
+     *
+     * \return the coroutine handle
+     */
+    inline std::coroutine_handle<> handle() const { return handle_; }
+
+    /**
+     * \brief Retrieves the value produced by a completed task
+     *
+     * If the task completed with an exception, it is rethrown.
+     *
+     * \return the produced value
+     */
+    inline T result() { return handle_.promise().take(); }
+
+    inline bool await_ready() const noexcept { return done(); }
+
+    inline std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle_.promise().continuation_ = awaiting;
+        return handle_;
+    }
+
+    inline T await_resume() { return result(); }
+};
+
+template<typename T>
+inline Task<T> detail::TaskPromise<T>::get_return_object() {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> detail::TaskPromise<void>::get_return_object() {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+/**
+ * \brief Tests whether a type is a \ref Task
+ *
+ * \tparam T the type
+ */
+template<typename T>
+struct is_task : std::false_type {};
+
+template<typename T>
+struct is_task<Task<T>> : std::true_type {};
+
+template<typename T>
+inline constexpr bool is_task_v = is_task<T>::value;
+
+}
+
+#endif
@@ -0,0 +1,331 @@
+#ifndef _OOCMD_THREAD_POOL_HPP
+#define _OOCMD_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <oocmd/util/cpu_set.hpp>
+
+namespace oocmd {
+
+/**
+ * \brief A work-stealing thread pool
+ *
+ * Each worker owns a task queue.
+ * Tasks submitted by a worker are pushed to its own queue, from which it takes the most recently submitted task first,
+ * whereas idle workers steal the least recently submitted tasks from the other workers' queues.
+ * Tasks submitted from outside the pool are distributed across the workers' queues round-robin.
+ *
+ * Waiting for tasks, either via \ref wait or \ref parallel_for , helps executing pending tasks, so that the pool can be used recursively.
+ * An exception escaping a task does not terminate the worker; instead, it is rethrown by the next call to \ref wait , or by \ref parallel_for if it escaped one of its iterations.
+ *
+ * Typically, the pool is not constructed directly but obtained from an \ref Application , which configures its size and pinning using standard parameters.
+ */
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * \brief Statistics of a single worker
+     */
+    struct WorkerStats {
+        uint64_t tasks = 0;                  ///< the number of tasks executed by the worker
+        uint64_t steals = 0;                 ///< the number of tasks stolen from other workers
+        uint64_t idle = 0;                   ///< the number of times the worker went to sleep for lack of tasks
+        std::chrono::nanoseconds idle_time{}; ///< the total time the worker slept
+    };
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> queue;
+
+        std::atomic<uint64_t> tasks = 0;
+        std::atomic<uint64_t> steals = 0;
+        std::atomic<uint64_t> idle = 0;
+        std::atomic<uint64_t> idle_ns = 0;
+    };
+
+    static constexpr size_t NO_WORKER = SIZE_MAX;
+
+    // identifies the worker running on the current thread, if any
+    struct WorkerSlot {
+        ThreadPool const* pool = nullptr;
+        size_t index = NO_WORKER;
+    };
+
+    static WorkerSlot& current_worker_slot() {
+        thread_local WorkerSlot slot;
+        return slot;
+    }
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::atomic<size_t> queued_ = 0;  // the number of tasks in any queue
+    std::atomic<size_t> pending_ = 0; // the number of submitted tasks that have not been completed
+    std::atomic<size_t> next_ = 0;    // the worker to receive the next external submission
+    bool stop_ = false;
+
+    std::mutex error_mutex_;
+    std::exception_ptr error_; // the first exception that escaped a task since the last wait
+
+    size_t worker_index() const {
+        auto const& slot = current_worker_slot();
+        return (slot.pool == this) ? slot.index : NO_WORKER;
+    }
+
+    void push(Task&& task) {
+        auto i = worker_index();
+        if(i == NO_WORKER) i = next_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+
+        {
+            std::lock_guard lock(workers_[i]->mutex);
+            workers_[i]->queue.push_back(std::move(task));
+        }
+        {
+            std::lock_guard lock(sleep_mutex_);
+            ++queued_;
+        }
+        wake_.notify_one();
+    }
+
+    // attempts to take a task, either from the own queue (if on a worker) or by stealing from another worker
+    bool take(Task& out_task) {
+        auto const self = worker_index();
+        if(self != NO_WORKER) {
+            auto& w = *workers_[self];
+            std::lock_guard lock(w.mutex);
+            if(!w.queue.empty()) {
+                out_task = std::move(w.queue.back());
+                w.queue.pop_back();
+                --queued_;
+                return true;
+            }
+        }
+
+        auto const n = workers_.size();
+        auto const start = (self != NO_WORKER) ? self + 1 : next_.load(std::memory_order_relaxed);
+        for(size_t k = 0; k < n; k++) {
+            auto const victim = (start + k) % n;
+            if(victim == self) continue;
+
+            auto& w = *workers_[victim];
+            std::lock_guard lock(w.mutex);
+            if(!w.queue.empty()) {
+                out_task = std::move(w.queue.front());
+                w.queue.pop_front();
+                --queued_;
+                if(self != NO_WORKER) workers_[self]->steals.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void execute(Task& task) {
+        try {
+            task();
+        } catch(...) {
+            std::lock_guard lock(error_mutex_);
+            if(!error_) error_ = std::current_exception();
+        }
+        task = nullptr;
+
+        auto const self = worker_index();
+        if(self != NO_WORKER) workers_[self]->tasks.fetch_add(1, std::memory_order_relaxed);
+
+        if(pending_.fetch_sub(1) == 1) {
+            std::lock_guard lock(sleep_mutex_);
+            done_.notify_all();
+        }
+    }
+
+    void work(size_t const i, int const cpu) {
+        current_worker_slot() = { this, i };
+        if(cpu >= 0) CpuSet::pin(unsigned(cpu));
+
+        auto& w = *workers_[i];
+        Task task;
+        while(true) {
+            if(take(task)) {
+                execute(task);
+                continue;
+            }
+
+            std::unique_lock lock(sleep_mutex_);
+            if(stop_) break;
+            if(queued_ == 0) {
+                w.idle.fetch_add(1, std::memory_order_relaxed);
+                auto const t0 = std::chrono::steady_clock::now();
+                wake_.wait(lock, [&]{ return stop_ || queued_ > 0; });
+                w.idle_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count(), std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // helps executing tasks until the given condition holds
+    template<typename Condition>
+    void help_until(Condition done) {
+        Task task;
+        while(!done()) {
+            if(take(task)) {
+                execute(task);
+            } else {
+                std::unique_lock lock(sleep_mutex_);
+                done_.wait_for(lock, std::chrono::microseconds(100), [&]{ return done() || queued_ > 0; });
+            }
+        }
+    }
+
+public:
+    /**
+     * \brief Starts a thread pool
+     *
+     * \param threads the number of worker threads, which is at least one
+     * \param pinning the CPUs to pin the workers to as computed by \ref CpuSet::plan , or empty if workers should not be pinned
+     */
+    inline ThreadPool(size_t threads, std::vector<unsigned> const& pinning = {}) {
+        threads = std::max(size_t(1), threads);
+
+        workers_.reserve(threads);
+        for(size_t i = 0; i < threads; i++) workers_.push_back(std::make_unique<Worker>());
+
+        threads_.reserve(threads);
+        for(size_t i = 0; i < threads; i++) {
+            int const cpu = pinning.empty() ? -1 : int(pinning[i % pinning.size()]);
+            threads_.emplace_back([this, i, cpu]{ work(i, cpu); });
+        }
+    }
+
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    /**
+     * \brief Waits for all pending tasks and shuts down the workers
+     */
+    inline ~ThreadPool() {
+        help_until([&]{ return pending_.load() == 0; });
+        {
+            std::lock_guard lock(sleep_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for(auto& t : threads_) t.join();
+    }
+
+    /**
+     * \brief Reports the number of worker threads
+     *
+     * \return the number of worker threads
+     */
+    inline size_t size() const { return threads_.size(); }
+
+    /**
+     * \brief Submits a task for execution
+     *
+     * \param task the task
+     */
+    inline void submit(Task task) {
+        ++pending_;
+        push(std::move(task));
+    }
+
+    /**
+     * \brief Waits until all submitted tasks have been completed
+     *
+     * The calling thread helps executing tasks while waiting.
+     * If an exception escaped any task since the last wait, the first such exception is rethrown after all tasks have been completed.
+     */
+    inline void wait() {
+        help_until([&]{ return pending_.load() == 0; });
+
+        std::exception_ptr error;
+        {
+            std::lock_guard lock(error_mutex_);
+            error = std::exchange(error_, nullptr);
+        }
+        if(error) std::rethrow_exception(error);
+    }
+
+    /**
+     * \brief Executes a function for each index in a range in parallel and waits for completion
+     *
+     * The range is split into chunks of the given grain size, each of which is executed as a task.
+     * The calling thread helps executing tasks while waiting, so this may be called from within a task.
+     * If an exception escapes the function, the remaining indices of the same chunk are skipped and the first such exception is rethrown after all chunks have been completed.
+     *
+     * \param begin the first index
+     * \param end the index after the last
+     * \param f the function, which accepts an index
+     * \param grain the number of indices per task, or zero to choose automatically
+     */
+    template<typename F>
+    void parallel_for(size_t const begin, size_t const end, F const& f, size_t grain = 0) {
+        if(end <= begin) return;
+
+        auto const n = end - begin;
+        if(grain == 0) grain = std::max(size_t(1), n / (4 * size()));
+
+        auto const chunks = (n + grain - 1) / grain;
+        std::atomic<size_t> remaining = chunks;
+        std::mutex error_mutex;
+        std::exception_ptr error;
+        for(size_t c = 0; c < chunks; c++) {
+            auto const b = begin + c * grain;
+            auto const e = std::min(end, b + grain);
+            submit([&f, &remaining, &error_mutex, &error, b, e]{
+                try {
+                    for(size_t i = b; i < e; i++) f(i);
+                } catch(...) {
+                    std::lock_guard lock(error_mutex);
+                    if(!error) error = std::current_exception();
+                }
+                remaining.fetch_sub(1, std::memory_order_release);
+            });
+        }
+
+        help_until([&]{ return remaining.load(std::memory_order_acquire) == 0; });
+        if(error) std::rethrow_exception(error);
+    }
+
+    /**
+     * \brief Reports statistics for each worker
+     *
+     * \return the statistics of each worker
+     */
+    inline std::vector<WorkerStats> stats() const {
+        std::vector<WorkerStats> v;
+        v.reserve(workers_.size());
+        for(auto const& w : workers_) {
+            WorkerStats s;
+            s.tasks = w->tasks.load(std::memory_order_relaxed);
+            s.steals = w->steals.load(std::memory_order_relaxed);
+            s.idle = w->idle.load(std::memory_order_relaxed);
+            s.idle_time = std::chrono::nanoseconds(w->idle_ns.load(std::memory_order_relaxed));
+            v.push_back(s);
+        }
+        return v;
+    }
+};
+
+}
+
+#endif
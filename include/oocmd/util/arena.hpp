@@ -0,0 +1,94 @@
+#ifndef _OOCMD_ARENA_HPP
+#define _OOCMD_ARENA_HPP
+
+#include <cstddef>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace oocmd {
+
+/**
+ * \brief Statistics of an \ref Arena
+ */
+struct ArenaStats {
+    size_t bytes = 0;       ///< the total number of bytes allocated from the upstream resource
+    size_t allocations = 0; ///< the number of allocations from the upstream resource
+};
+
+/**
+ * \brief A monotonic memory arena that reports how much memory it allocated
+ *
+ * All memory allocated from the arena is released at once when the arena is destroyed or \ref release "released".
+ * It grows by allocating geometrically increasing blocks from the global heap.
+ */
+class Arena {
+private:
+    // forwards to the global heap, counting allocations
+    class CountingResource : public std::pmr::memory_resource {
+    private:
+        ArenaStats stats_;
+
+        void* do_allocate(size_t const bytes, size_t const alignment) override {
+            stats_.bytes += bytes;
+            ++stats_.allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, size_t const bytes, size_t const alignment) override {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override { return this == &other; }
+
+    public:
+        inline ArenaStats const& stats() const { return stats_; }
+    };
+
+    CountingResource upstream_;
+    std::pmr::monotonic_buffer_resource arena_;
+
+public:
+    /**
+     * \brief Constructs an arena
+     *
+     * No memory is allocated until the arena is first used.
+     *
+     * \param initial_size the size of the first block allocated from the heap
+     */
+    inline Arena(size_t const initial_size = 4096) : arena_(initial_size, &upstream_) {
+    }
+
+    Arena(Arena const&) = delete;
+    Arena& operator=(Arena const&) = delete;
+
+    /**
+     * \brief Provides the memory resource to allocate from
+     *
+     * \return the memory resource
+     */
+    inline std::pmr::memory_resource* resource() { return &arena_; }
+
+    /**
+     * \brief Reports the memory allocated by the arena so far
+     *
+     * \return the arena statistics
+     */
+    inline ArenaStats const& stats() const { return upstream_.stats(); }
+
+    /**
+     * \brief Releases all memory allocated from the arena
+     */
+    inline void release() { arena_.release(); }
+};
+
+// a list of error messages, allocated from a memory resource
+using ErrorList = std::pmr::vector<std::pmr::string>;
+
+// a string stream for building error messages, allocating from a memory resource
+using ErrorStream = std::basic_ostringstream<char, std::char_traits<char>, std::pmr::polymorphic_allocator<char>>;
+
+}
+
+#endif
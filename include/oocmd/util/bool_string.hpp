@@ -3,6 +3,7 @@
 
 #include <cctype>
 #include <string>
+#include <string_view>
 
 namespace oocmd {
 
@@ -18,11 +19,21 @@ inline bool iequals(char const* s1, char const* s2) {
     return (*s1 == 0 && *s2 == 0);
 }
 
+inline bool iequals(std::string_view const s1, std::string_view const s2) {
+    if(s1.size() != s2.size()) return false;
+    for(size_t i = 0; i < s1.size(); i++) {
+        if(std::tolower((unsigned char)s1[i]) != std::tolower((unsigned char)s2[i])) return false;
+    }
+    return true;
+}
+
 inline bool string_contains_true(char const* s) { return iequals(s, "1") || iequals(s, "on") || iequals(s, "true"); };
 inline bool string_contains_true(std::string const& s) { return string_contains_true(s.c_str()); }
+inline bool string_contains_true(std::string_view const s) { return iequals(s, "1") || iequals(s, "on") || iequals(s, "true"); }
 
 inline bool string_contains_false(char const* s) { return iequals(s, "0") || iequals(s, "off") || iequals(s, "false"); };
 inline bool string_contains_false(std::string const& s) { return string_contains_false(s.c_str()); }
+inline bool string_contains_false(std::string_view const s) { return iequals(s, "0") || iequals(s, "off") || iequals(s, "false"); }
 
 }
 
@@ -0,0 +1,70 @@
+#ifndef _OOCMD_CONFIG_FILE_HPP
+#define _OOCMD_CONFIG_FILE_HPP
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <oocmd/util/arena.hpp>
+
+namespace oocmd {
+
+// converts a configuration as reported by ConfigObject::config into the form parsed from the command line, i.e., all values become strings
+inline nlohmann::json stringify_config(nlohmann::json const& config) {
+    if(config.is_object()) {
+        auto result = nlohmann::json::object();
+        for(auto const& [key, v] : config.items()) {
+            if(!v.is_null()) result[key] = stringify_config(v);
+        }
+        return result;
+    } else if(config.is_array()) {
+        auto result = nlohmann::json::array();
+        for(auto const& item : config) result.push_back(stringify_config(item));
+        return result;
+    } else if(config.is_string()) {
+        return config;
+    } else {
+        return config.dump();
+    }
+}
+
+// merges a configuration into another, overriding existing values
+inline void merge_config(nlohmann::json& dst, nlohmann::json const& src) {
+    if(src.is_null()) return;
+    if(!dst.is_object() || !src.is_object()) {
+        dst = src;
+        return;
+    }
+
+    for(auto const& [key, v] : src.items()) {
+        if(dst.contains(key) && dst[key].is_object() && v.is_object()) {
+            merge_config(dst[key], v);
+        } else {
+            dst[key] = v;
+        }
+    }
+}
+
+// loads a JSON configuration file as written by ConfigObject::config and converts it into the form parsed from the command line
+inline bool load_config_file(std::string const& path, nlohmann::json& out_config, ErrorList& errors) {
+    std::ifstream f(path);
+    if(!f) {
+        errors.emplace_back("failed to open configuration file \"" + path + "\"");
+        return false;
+    }
+
+    auto const json = nlohmann::json::parse(f, nullptr, false);
+    if(json.is_discarded() || !json.is_object()) {
+        errors.emplace_back("configuration file \"" + path + "\" does not contain a JSON object");
+        return false;
+    }
+
+    out_config = stringify_config(json);
+    return true;
+}
+
+}
+
+#endif
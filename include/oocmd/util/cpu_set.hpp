@@ -0,0 +1,263 @@
+#ifndef _OOCMD_CPU_SET_HPP
+#define _OOCMD_CPU_SET_HPP
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <sched.h>
+
+#include <oocmd/util/enum_table.hpp>
+#include <oocmd/util/machine.hpp>
+#include <oocmd/util/value_traits.hpp>
+
+namespace oocmd {
+
+/**
+ * \brief Strategies for placing worker threads on the CPUs of a \ref CpuSet
+ */
+enum class Placement {
+    compact, ///< fill the cores of one socket before moving on to the next, placing hyperthreads next to each other
+    scatter  ///< distribute workers round-robin across sockets, using distinct physical cores before hyperthreads
+};
+
+template<> struct enum_names<Placement> {
+    static constexpr auto table = make_enum_table<Placement>({ { "compact", Placement::compact }, { "scatter", Placement::scatter } });
+};
+
+/**
+ * \brief A set of CPUs, e.g., to pin worker threads to
+ *
+ * As a config parameter, CPU sets are given in an extended cpulist syntax, which is a comma-separated list of the following items:
+ * - \c N selects CPU \c N ,
+ * - <tt>N-M</tt> selects CPUs \c N through \c M ,
+ * - <tt>node:K</tt> selects all CPUs of NUMA node \c K , and
+ * - \c all selects all online CPUs.
+ *
+ * Any item may be prefixed by <tt>!</tt> in order to exclude the respective CPUs instead.
+ * If only exclusions are given, they are applied to the set of all online CPUs.
+ * For example, <tt>0-7,16-23</tt> selects 16 CPUs, <tt>node:1</tt> selects the CPUs of the second NUMA node, and <tt>!0</tt> selects all online CPUs except the first.
+ *
+ * Parsing fails if any selected CPU is not online, any NUMA node does not exist, or no CPU remains selected after exclusions, e.g., for <tt>!all</tt> .
+ *
+ * An empty CPU set represents no restriction, i.e., all online CPUs are used for \ref plan "pinning plans".
+ */
+class CpuSet {
+private:
+    std::bitset<machine::MAX_CPUS> cpus_;
+
+public:
+    /**
+     * \brief Constructs an empty CPU set
+     */
+    inline CpuSet() {
+    }
+
+    /**
+     * \brief Constructs a CPU set from a bitset
+     *
+     * \param cpus the bitset of CPUs
+     */
+    inline CpuSet(std::bitset<machine::MAX_CPUS> const& cpus) : cpus_(cpus) {
+    }
+
+    /**
+     * \brief Constructs the set of all online CPUs
+     *
+     * \return the set of all online CPUs
+     */
+    static inline CpuSet online() { return CpuSet(machine::online_cpus()); }
+
+    inline bool empty() const { return cpus_.none(); }
+    inline size_t size() const { return cpus_.count(); }
+    inline bool contains(unsigned const cpu) const { return cpu < machine::MAX_CPUS && cpus_.test(cpu); }
+    inline std::bitset<machine::MAX_CPUS> const& bits() const { return cpus_; }
+
+    inline bool operator==(CpuSet const&) const = default;
+
+    /**
+     * \brief Lists the contained CPUs in ascending order
+     *
+     * \return the contained CPUs
+     */
+    inline std::vector<unsigned> list() const {
+        std::vector<unsigned> v;
+        v.reserve(size());
+        for(unsigned cpu = 0; cpu < machine::MAX_CPUS; cpu++) {
+            if(cpus_.test(cpu)) v.push_back(cpu);
+        }
+        return v;
+    }
+
+    /**
+     * \brief Computes a pinning plan for the given number of workers
+     *
+     * The plan is the ordered list of CPUs that the workers should be pinned to, i.e., worker \c i should be pinned to the i-th CPU in the plan.
+     * If there are more workers than CPUs, CPUs are assigned repeatedly in the same order.
+     * If the set is empty, all online CPUs are used.
+     *
+     * \param workers the number of workers
+     * \param placement the placement strategy
+     * \return the pinning plan
+     */
+    inline std::vector<unsigned> plan(size_t const workers, Placement const placement = Placement::compact) const {
+        auto const cpus = empty() ? online().list() : list();
+
+        // order CPUs by (package, core, cpu), and determine their rank within their core
+        struct Location { unsigned package, core, cpu, thread; };
+        std::vector<Location> locations;
+        locations.reserve(cpus.size());
+        for(auto const cpu : cpus) {
+            Location loc;
+            loc.cpu = cpu;
+            machine::cpu_location(cpu, loc.package, loc.core);
+            locations.push_back(loc);
+        }
+        std::sort(locations.begin(), locations.end(), [](Location const& a, Location const& b){
+            return std::tie(a.package, a.core, a.cpu) < std::tie(b.package, b.core, b.cpu);
+        });
+        for(size_t i = 0; i < locations.size(); i++) {
+            auto const same_core = i > 0 && locations[i - 1].package == locations[i].package && locations[i - 1].core == locations[i].core;
+            locations[i].thread = same_core ? locations[i - 1].thread + 1 : 0;
+        }
+
+        std::vector<unsigned> order;
+        order.reserve(locations.size());
+        if(placement == Placement::compact) {
+            for(auto const& loc : locations) order.push_back(loc.cpu);
+        } else {
+            // per package, prefer distinct cores over hyperthreads, then interleave packages
+            std::map<unsigned, std::vector<Location>> packages;
+            for(auto const& loc : locations) packages[loc.package].push_back(loc);
+            for(auto& [package, locs] : packages) {
+                std::stable_sort(locs.begin(), locs.end(), [](Location const& a, Location const& b){ return a.thread < b.thread; });
+            }
+
+            for(size_t i = 0; order.size() < locations.size(); i++) {
+                for(auto const& [package, locs] : packages) {
+                    if(i < locs.size()) order.push_back(locs[i].cpu);
+                }
+            }
+        }
+
+        std::vector<unsigned> plan;
+        plan.reserve(workers);
+        for(size_t i = 0; i < workers; i++) {
+            plan.push_back(order[i % order.size()]);
+        }
+        return plan;
+    }
+
+    /**
+     * \brief Pins the calling thread to the given CPU
+     *
+     * \param cpu the CPU
+     * \return true if the thread was pinned
+     * \return false otherwise
+     */
+    static inline bool pin(unsigned const cpu) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return sched_setaffinity(0, sizeof(set), &set) == 0;
+    }
+};
+
+/**
+ * \brief Parses a CPU set in the extended cpulist syntax described in \ref CpuSet
+ *
+ * \param s the string to parse
+ * \param out_v receives the parsed CPU set
+ * \return true if the string is well-formed, all selected CPUs and NUMA nodes exist and at least one CPU remains selected after exclusions
+ * \return false otherwise
+ */
+inline bool parse_cpu_set(std::string_view s, CpuSet& out_v) {
+    auto const online = machine::online_cpus();
+
+    std::bitset<machine::MAX_CPUS> include, exclude;
+    bool any_include = false;
+
+    while(!s.empty()) {
+        auto const comma = s.find(',');
+        auto item = s.substr(0, comma);
+        s = (comma == std::string_view::npos) ? std::string_view() : s.substr(comma + 1);
+
+        while(item.starts_with(' ')) item.remove_prefix(1);
+        while(item.ends_with(' ')) item.remove_suffix(1);
+        if(item.empty()) return false;
+
+        bool const negate = item.starts_with('!');
+        if(negate) item.remove_prefix(1);
+
+        std::bitset<machine::MAX_CPUS> cpus;
+        if(item == "all") {
+            cpus = online;
+        } else if(item.starts_with("node:")) {
+            std::string const num(item.substr(5));
+            char* end;
+            auto const node = std::strtoul(num.c_str(), &end, 10);
+            if(num.empty() || *end != 0 || !machine::numa_node_cpus(unsigned(node), cpus)) return false;
+        } else if(!machine::parse_cpulist(item, cpus)) {
+            return false;
+        }
+
+        if((cpus & ~online).any()) return false; // not all CPUs are online
+
+        if(negate) {
+            exclude |= cpus;
+        } else {
+            include |= cpus;
+            any_include = true;
+        }
+    }
+
+    if(!any_include) include = online;
+
+    // an empty set would select all CPUs, which is not what excluding everything means
+    auto const selected = include & ~exclude;
+    if(selected.none()) return false;
+
+    out_v = CpuSet(selected);
+    return true;
+}
+
+/**
+ * \brief Formats a CPU set in the kernel's cpulist format, e.g., <tt>0-7,16-23</tt>
+ *
+ * \param v the CPU set
+ * \return the formatted CPU set
+ */
+inline std::string make_cpu_set_string(CpuSet const& v) {
+    std::string s;
+    auto const& bits = v.bits();
+    for(size_t cpu = 0; cpu < bits.size(); cpu++) {
+        if(bits.test(cpu)) {
+            auto last = cpu;
+            while(last + 1 < bits.size() && bits.test(last + 1)) ++last;
+
+            if(!s.empty()) s.push_back(',');
+            s.append(std::to_string(cpu));
+            if(last > cpu) s.append("-").append(std::to_string(last));
+            cpu = last;
+        }
+    }
+    return s;
+}
+
+// value traits for CPU sets
+template<>
+struct value_traits<CpuSet> {
+    static bool parse(std::string_view s, CpuSet& out_v) { return parse_cpu_set(s, out_v); }
+    static std::string format(CpuSet const& v) { return v.empty() ? "all" : make_cpu_set_string(v); }
+    static std::string type_name() { return "cpulist"; }
+};
+
+}
+
+#endif
@@ -0,0 +1,210 @@
+#ifndef _OOCMD_DURATION_HPP
+#define _OOCMD_DURATION_HPP
+
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <oocmd/util/value_traits.hpp>
+
+namespace oocmd {
+
+// a time unit as a fraction of seconds
+struct TimeUnit {
+    char const* name;
+    uint64_t num;
+    uint64_t den;
+};
+
+// the supported time units, in descending order of length
+inline constexpr TimeUnit TIME_UNITS[] = {
+    { "d",   86400, 1 },
+    { "h",   3600,  1 },
+    { "min", 60,    1 },
+    { "s",   1,     1 },
+    { "ms",  1,     1'000 },
+    { "us",  1,     1'000'000 },
+    { "ns",  1,     1'000'000'000 },
+};
+
+// parses a time unit at the given position and advances it; an empty unit is not accepted
+inline bool parse_time_unit(char const*& p, TimeUnit& out_unit) {
+    static constexpr char const* MICRO = "µ"; // accept "µs" as an alias of "us"
+
+    std::string_view s(p);
+    std::string_view name;
+    if(s.starts_with("min")) {
+        out_unit = TIME_UNITS[2]; name = "min";
+    } else if(s.starts_with(MICRO)) {
+        if(!s.substr(std::char_traits<char>::length(MICRO)).starts_with("s")) return false;
+        out_unit = TIME_UNITS[5]; name = s.substr(0, std::char_traits<char>::length(MICRO) + 1);
+    } else {
+        // find the longest matching unit name, treating "m" as an alias of "min"
+        size_t best = 0;
+        for(auto const& unit : TIME_UNITS) {
+            std::string_view unit_name(unit.name);
+            if(s.starts_with(unit_name) && unit_name.length() > best) {
+                out_unit = unit; best = unit_name.length();
+            }
+        }
+        if(best == 0 && s.starts_with("m")) {
+            out_unit = TIME_UNITS[2]; best = 1;
+        }
+        if(best == 0) return false;
+        name = s.substr(0, best);
+    }
+    p += name.length();
+    return true;
+}
+
+/**
+ * \brief Parses a duration string, e.g., \c 250us , \c 1.5ms or \c 2m
+ *
+ * The string consists of a (possibly fractional) number followed by a time unit, which is one of
+ * \c ns , \c us (or \c µs ), \c ms , \c s , \c m (or \c min ), \c h or \c d .
+ * The number zero may be given without a unit.
+ *
+ * For integral representations, parsing fails if the duration cannot be represented exactly or if it overflows the representation.
+ *
+ * \tparam Rep the representation type of the duration
+ * \tparam Period the period of the duration
+ * \param s the string to parse
+ * \param out_v receives the parsed duration
+ * \return true if parsing succeeded
+ * \return false otherwise
+ */
+template<typename Rep, typename Period>
+bool parse_duration(std::string_view s, std::chrono::duration<Rep, Period>& out_v) {
+    using u128 = unsigned __int128;
+
+    std::string str(s); // ensure null termination
+    char const* p = str.c_str();
+    while(*p == ' ') ++p;
+
+    bool const negative = (*p == '-');
+    if(negative) {
+        if constexpr(std::is_unsigned_v<Rep>) return false;
+        ++p;
+    }
+
+    // parse mantissa and decimal exponent exactly
+    uint64_t mantissa = 0;
+    uint64_t scale = 1;
+    bool any_digit = false, fraction = false;
+    for(; (*p >= '0' && *p <= '9') || (*p == '.' && !fraction); ++p) {
+        if(*p == '.') {
+            fraction = true;
+            continue;
+        }
+
+        any_digit = true;
+        if(__builtin_mul_overflow(mantissa, uint64_t(10), &mantissa) || __builtin_add_overflow(mantissa, uint64_t(*p - '0'), &mantissa)) return false;
+        if(fraction && __builtin_mul_overflow(scale, uint64_t(10), &scale)) return false;
+    }
+    if(!any_digit) return false;
+
+    while(*p == ' ') ++p;
+
+    // parse unit
+    TimeUnit unit;
+    if(*p == 0 && mantissa == 0) {
+        unit = TIME_UNITS[3];
+    } else if(!parse_time_unit(p, unit)) {
+        return false;
+    }
+
+    while(*p == ' ') ++p;
+    if(*p != 0) return false;
+
+    // compute mantissa / scale * unit / Period
+    u128 num = u128(mantissa) * unit.num;
+    u128 den = u128(scale) * unit.den;
+    if(__builtin_mul_overflow(num, u128(Period::den), &num) || __builtin_mul_overflow(den, u128(Period::num), &den)) return false;
+
+    if constexpr(std::is_floating_point_v<Rep>) {
+        auto const v = Rep((long double)num / (long double)den);
+        out_v = std::chrono::duration<Rep, Period>(negative ? -v : v);
+    } else {
+        if(num % den != 0) return false; // not representable
+        auto const count = num / den;
+        if(count > u128(std::numeric_limits<Rep>::max()) + (negative ? 1 : 0)) return false; // overflow
+
+        Rep r;
+        if(negative) {
+            r = (count == u128(std::numeric_limits<Rep>::max()) + 1) ? std::numeric_limits<Rep>::min() : -Rep(count);
+        } else {
+            r = Rep(count);
+        }
+        out_v = std::chrono::duration<Rep, Period>(r);
+    }
+    return true;
+}
+
+/**
+ * \brief Formats a duration such that it can be parsed again using \ref parse_duration
+ *
+ * Integral durations are formatted exactly in the longest time unit that can represent them as an integer, e.g., 1.5 milliseconds are formatted as \c 1500us .
+ *
+ * \tparam Rep the representation type of the duration
+ * \tparam Period the period of the duration
+ * \param v the duration
+ * \return the formatted duration
+ */
+template<typename Rep, typename Period>
+std::string make_duration_string(std::chrono::duration<Rep, Period> v) {
+    using u128 = unsigned __int128;
+
+    auto seconds_string = [](double seconds) {
+        char buf[32];
+        auto const r = std::to_chars(buf, buf + sizeof(buf), seconds);
+        return std::string(buf, r.ptr).append("s");
+    };
+
+    if constexpr(std::is_floating_point_v<Rep>) {
+        // format in seconds
+        return seconds_string(std::chrono::duration<double>(v).count());
+    } else {
+        auto const c = v.count();
+        bool const negative = c < 0;
+        u128 const abs = negative ? u128(-(c + 1)) + 1 : u128(c);
+        std::string const sign = negative ? "-" : "";
+
+        if(abs == 0) return "0s";
+
+        // value in seconds is abs * Period::num / Period::den, find longest unit that divides it
+        for(auto const& unit : TIME_UNITS) {
+            u128 num, den;
+            if(__builtin_mul_overflow(abs, u128(Period::num) * unit.den, &num)) continue;
+            den = u128(Period::den) * unit.num;
+            if(num % den == 0) {
+                auto const n = num / den;
+                if(n <= std::numeric_limits<uint64_t>::max()) {
+                    return sign + std::to_string(uint64_t(n)) + unit.name;
+                }
+            }
+        }
+
+        // the period cannot be represented exactly by any unit, format in seconds
+        return seconds_string(std::chrono::duration<double>(v).count());
+    }
+}
+
+// value traits for durations
+template<typename Rep, typename Period>
+struct value_traits<std::chrono::duration<Rep, Period>> {
+    using Duration = std::chrono::duration<Rep, Period>;
+
+    static bool parse(std::string_view s, Duration& out_v) { return parse_duration(s, out_v); }
+    static std::string format(Duration const& v) { return make_duration_string(v); }
+    static std::string type_name() { return "duration"; }
+};
+
+}
+
+#endif
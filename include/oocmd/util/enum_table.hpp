@@ -0,0 +1,165 @@
+#ifndef _OOCMD_ENUM_TABLE_HPP
+#define _OOCMD_ENUM_TABLE_HPP
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace oocmd {
+
+/**
+ * \brief A compile-time table of names for the values of an enumeration
+ *
+ * Names are looked up using a perfect hash function that is computed at compile time,
+ * so that parsing a name requires hashing it once and doing at most one string comparison.
+ *
+ * Tables are typically created using \ref make_enum_table .
+ *
+ * \tparam E the enumeration type
+ * \tparam N the number of names
+ */
+template<typename E, size_t N>
+requires std::is_enum_v<E> && (N > 0)
+class EnumTable {
+public:
+    using Entry = std::pair<std::string_view, E>;
+
+private:
+    static constexpr size_t NUM_SLOTS = std::bit_ceil(4 * N);
+    static constexpr size_t EMPTY = SIZE_MAX;
+    static constexpr uint64_t MAX_SEEDS = 1ULL << 16;
+
+    static constexpr size_t hash(std::string_view s, uint64_t seed) {
+        // FNV-1a, salted with the seed
+        uint64_t h = 0xCBF29CE484222325ULL ^ (seed * 0x9E3779B97F4A7C15ULL);
+        for(char const c : s) {
+            h ^= (unsigned char)c;
+            h *= 0x100000001B3ULL;
+        }
+        return (h ^ (h >> 32)) & (NUM_SLOTS - 1);
+    }
+
+    std::array<Entry, N> entries_;
+    std::array<size_t, NUM_SLOTS> slots_;
+    uint64_t seed_;
+
+public:
+    /**
+     * \brief Constructs the table and computes a perfect hash function for the given names
+     *
+     * \param entries the names and the enumeration values they represent
+     */
+    constexpr EnumTable(std::array<Entry, N> const& entries) : entries_(entries), slots_(), seed_(0) {
+        for(; seed_ < MAX_SEEDS; seed_++) {
+            slots_.fill(EMPTY);
+
+            bool collision = false;
+            for(size_t i = 0; i < N && !collision; i++) {
+                auto const h = hash(entries_[i].first, seed_);
+                if(slots_[h] == EMPTY) {
+                    slots_[h] = i;
+                } else if(entries_[slots_[h]].first == entries_[i].first) {
+                    throw std::invalid_argument("enum table contains duplicate names");
+                } else {
+                    collision = true;
+                }
+            }
+
+            if(!collision) return;
+        }
+        throw std::invalid_argument("failed to compute a perfect hash function for the enum table");
+    }
+
+    /**
+     * \brief Looks up the value with the given name
+     *
+     * \param name the name
+     * \param out_v receives the value with the given name, if any
+     * \return true if the name was found
+     * \return false otherwise
+     */
+    constexpr bool find(std::string_view name, E& out_v) const {
+        auto const i = slots_[hash(name, seed_)];
+        if(i != EMPTY && entries_[i].first == name) {
+            out_v = entries_[i].second;
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    /**
+     * \brief Reports the name of the given value
+     *
+     * If multiple names represent the value, the first one is reported.
+     *
+     * \param v the value
+     * \return the name of the value, or an empty string if the value has no name
+     */
+    constexpr std::string_view name(E v) const {
+        for(auto const& e : entries_) {
+            if(e.second == v) return e.first;
+        }
+        return std::string_view();
+    }
+
+    /**
+     * \brief Provides access to the table's entries in order of declaration
+     *
+     * \return the table's entries
+     */
+    constexpr std::array<Entry, N> const& entries() const { return entries_; }
+};
+
+/**
+ * \brief Creates a compile-time name table for an enumeration
+ *
+ * Example:
+ * \code{.cpp}
+ * enum class Mode { fast, safe };
+ *
+ * template<> struct oocmd::enum_names<Mode> {
+ *     static constexpr auto table = oocmd::make_enum_table<Mode>({ { "fast", Mode::fast }, { "safe", Mode::safe } });
+ * };
+ * \endcode
+ *
+ * \tparam E the enumeration type
+ * \tparam N the number of names
+ * \param entries the names and the enumeration values they represent
+ * \return the name table
+ */
+template<typename E, size_t N>
+constexpr EnumTable<E, N> make_enum_table(std::pair<std::string_view, E> const (&entries)[N]) {
+    return EnumTable<E, N>(std::to_array(entries));
+}
+
+/**
+ * \brief Customization point providing the names of an enumeration's values
+ *
+ * Specializations must provide a static constexpr member named \c table , which is an \ref EnumTable typically created using \ref make_enum_table .
+ *
+ * \tparam E the enumeration type
+ */
+template<typename E>
+struct enum_names;
+
+/**
+ * \brief Requires a type to be an enumeration with an \ref enum_names specialization
+ *
+ * \tparam E the type
+ */
+template<typename E>
+concept NamedEnum = std::is_enum_v<E> && requires(std::string_view name, E& v) {
+    { enum_names<E>::table.find(name, v) } -> std::same_as<bool>;
+    { enum_names<E>::table.name(v) } -> std::same_as<std::string_view>;
+};
+
+}
+
+#endif
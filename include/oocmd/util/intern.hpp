@@ -0,0 +1,75 @@
+#ifndef _OOCMD_INTERN_HPP
+#define _OOCMD_INTERN_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace oocmd {
+
+namespace detail {
+
+struct InternHash {
+    using is_transparent = void;
+    inline size_t operator()(std::string_view const s) const { return std::hash<std::string_view>()(s); }
+};
+
+// a direct-mapped cache from the addresses of recently interned strings to their pooled copies
+// string literals keep their address, so repeated registrations of the same parameter skip the pool's lock and hashing
+struct InternCache {
+    static constexpr size_t SIZE = 256;
+
+    struct Entry {
+        char const* data = nullptr;
+        std::string const* pooled = nullptr;
+    };
+
+    std::array<Entry, SIZE> entries;
+
+    inline Entry& slot(char const* data) { return entries[(reinterpret_cast<uintptr_t>(data) >> 3) % SIZE]; }
+};
+
+}
+
+/**
+ * \brief Interns a string in the process-wide string pool
+ *
+ * Equal strings are stored only once, and interned strings are never released.
+ * Thus, the returned reference remains valid for the lifetime of the process and may be shared freely.
+ * This is used for parameter names and descriptions, which are the same for every instance of a config object type.
+ *
+ * \param s the string to intern
+ * \return a reference to the pooled copy of the string
+ */
+inline std::string const& intern(std::string_view const s) {
+    static std::string const empty;
+    if(s.empty()) return empty;
+
+    // the cached entry may refer to a different string that occupied the same address before, so the contents are verified
+    thread_local detail::InternCache cache;
+    auto& entry = cache.slot(s.data());
+    if(entry.data == s.data() && *entry.pooled == s) return *entry.pooled;
+
+    static std::mutex mutex;
+    static std::unordered_set<std::string, detail::InternHash, std::equal_to<>> pool;
+
+    std::string const* pooled;
+    {
+        std::lock_guard lock(mutex);
+        auto it = pool.find(s);
+        if(it == pool.end()) it = pool.emplace(s).first;
+        pooled = &*it;
+    }
+
+    entry = { s.data(), pooled };
+    return *pooled;
+}
+
+}
+
+#endif
@@ -0,0 +1,396 @@
+#ifndef _OOCMD_MACHINE_HPP
+#define _OOCMD_MACHINE_HPP
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <sched.h>
+#include <unistd.h>
+
+namespace oocmd::machine {
+
+// reads the first line of a (pseudo) file, reporting whether it could be read
+inline bool read_line(std::string const& path, std::string& out_line) {
+    std::ifstream f(path);
+    return f && std::getline(f, out_line);
+}
+
+// finds the cgroup path of the current process for the given controller, or the unified (v2) hierarchy if the controller is empty
+inline bool cgroup_path(std::string const& controller, std::string& out_path) {
+    std::ifstream f("/proc/self/cgroup");
+    std::string line;
+    while(f && std::getline(f, line)) {
+        // lines are formatted as "<id>:<controllers>:<path>"
+        auto const a = line.find(':');
+        auto const b = line.find(':', a + 1);
+        if(a == std::string::npos || b == std::string::npos) continue;
+
+        auto const controllers = line.substr(a + 1, b - a - 1);
+        bool match;
+        if(controller.empty()) {
+            match = controllers.empty();
+        } else {
+            match = false;
+            std::istringstream list(controllers);
+            std::string c;
+            while(std::getline(list, c, ',')) match = match || (c == controller);
+        }
+
+        if(match) {
+            out_path = line.substr(b + 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * \brief Reports the total amount of physical memory in bytes
+ *
+ * \return the total amount of physical memory, or zero if it cannot be determined
+ */
+inline uint64_t physical_memory() {
+    std::ifstream f("/proc/meminfo");
+    std::string key, unit;
+    uint64_t value;
+    while(f >> key >> value) {
+        std::getline(f, unit);
+        if(key == "MemTotal:") return value * 1024; // reported in kB
+    }
+
+    auto const pages = sysconf(_SC_PHYS_PAGES);
+    auto const page_size = sysconf(_SC_PAGESIZE);
+    return (pages > 0 && page_size > 0) ? uint64_t(pages) * uint64_t(page_size) : 0;
+}
+
+/**
+ * \brief Reports the memory limit imposed on the current process by its cgroup
+ *
+ * Both the unified (v2) hierarchy (\c memory.max ) and the legacy (v1) memory controller (\c memory.limit_in_bytes ) are considered.
+ *
+ * \return the memory limit in bytes, or the total amount of physical memory if there is no limit
+ */
+inline uint64_t cgroup_memory_limit() {
+    // values this large are used by cgroup v1 to indicate "no limit"
+    static constexpr uint64_t UNLIMITED = 1ULL << 62;
+
+    auto const ram = physical_memory();
+    auto const limit = [&](std::string const& path, uint64_t& out_limit){
+        std::string line;
+        if(!read_line(path, line)) return false;
+        if(line == "max") {
+            out_limit = ram;
+        } else {
+            try {
+                out_limit = std::stoull(line);
+            } catch(std::exception const&) {
+                return false;
+            }
+            if(out_limit >= UNLIMITED) out_limit = ram;
+        }
+        return true;
+    };
+
+    std::string path;
+    uint64_t out_limit;
+    if(cgroup_path("", path) && limit("/sys/fs/cgroup" + path + "/memory.max", out_limit)) return std::min(out_limit, ram);
+    if(cgroup_path("memory", path) && limit("/sys/fs/cgroup/memory" + path + "/memory.limit_in_bytes", out_limit)) return std::min(out_limit, ram);
+    if(limit("/sys/fs/cgroup/memory/memory.limit_in_bytes", out_limit)) return std::min(out_limit, ram);
+    return ram;
+}
+
+/**
+ * \brief Reports the size of the CPU cache at the given level as seen by the first CPU
+ *
+ * For the first level, the size of the data cache is reported.
+ *
+ * \param level the cache level, e.g., 2 for the L2 cache
+ * \return the cache size in bytes, or zero if it cannot be determined
+ */
+inline uint64_t cache_size(unsigned const level) {
+    for(unsigned index = 0;; index++) {
+        auto const dir = "/sys/devices/system/cpu/cpu0/cache/index" + std::to_string(index) + "/";
+
+        std::string line;
+        if(!read_line(dir + "level", line)) break;
+        if(line != std::to_string(level)) continue;
+        if(read_line(dir + "type", line) && line == "Instruction") continue;
+
+        if(read_line(dir + "size", line)) {
+            // sysfs reports sizes like "32K", which are meant as binary units
+            char* unit;
+            uint64_t const size = std::strtoull(line.c_str(), &unit, 10);
+            switch(*unit) {
+                case 'K': return size << 10;
+                case 'M': return size << 20;
+                case 'G': return size << 30;
+                default:  return size;
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief Reports the number of CPU cores available to the current process
+ *
+ * This respects the scheduler affinity mask of the process as well as a CPU quota imposed by its cgroup
+ * (\c cpu.max in the unified hierarchy or \c cpu.cfs_quota_us in the legacy cpu controller).
+ *
+ * \return the number of available CPU cores, which is at least one
+ */
+inline unsigned available_cores() {
+    unsigned cores = std::max(1U, std::thread::hardware_concurrency());
+
+    // respect affinity mask
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if(sched_getaffinity(0, sizeof(set), &set) == 0) {
+        cores = std::max(1, CPU_COUNT(&set));
+    }
+
+    // respect cgroup quota
+    auto const quota = [&](int64_t q, int64_t period) {
+        if(q > 0 && period > 0) {
+            cores = std::min(cores, unsigned(std::max(int64_t(1), (q + period - 1) / period)));
+        }
+    };
+
+    std::string path, line;
+    if(cgroup_path("", path) && read_line("/sys/fs/cgroup" + path + "/cpu.max", line)) {
+        // formatted as "<quota> <period>", where quota may be "max"
+        std::istringstream s(line);
+        std::string q;
+        int64_t period;
+        if(s >> q >> period && q != "max") {
+            try {
+                quota(std::stoll(q), period);
+            } catch(std::exception const&) {
+            }
+        }
+    } else if(cgroup_path("cpu", path)) {
+        std::string period;
+        auto const dir = "/sys/fs/cgroup/cpu" + (std::ifstream("/sys/fs/cgroup/cpu" + path + "/cpu.cfs_quota_us") ? path : std::string()) + "/";
+        if(read_line(dir + "cpu.cfs_quota_us", line) && read_line(dir + "cpu.cfs_period_us", period)) {
+            try {
+                quota(std::stoll(line), std::stoll(period));
+            } catch(std::exception const&) {
+            }
+        }
+    }
+
+    return cores;
+}
+
+// the maximum number of CPUs supported by CPU sets, matching the size of the kernel's cpu_set_t
+inline constexpr size_t MAX_CPUS = CPU_SETSIZE;
+
+/**
+ * \brief Parses a list of CPUs in the kernel's cpulist format, e.g., <tt>0-7,16-23</tt>
+ *
+ * \param list the list
+ * \param out_cpus receives the listed CPUs (in addition to those already contained)
+ * \return true if the list is well-formed
+ * \return false otherwise
+ */
+inline bool parse_cpulist(std::string_view list, std::bitset<MAX_CPUS>& out_cpus) {
+    std::string const s(list);
+    char const* p = s.c_str();
+    while(*p) {
+        char* end;
+        auto const first = std::strtoul(p, &end, 10);
+        if(end == p) return false;
+        p = end;
+
+        auto last = first;
+        if(*p == '-') {
+            ++p;
+            last = std::strtoul(p, &end, 10);
+            if(end == p) return false;
+            p = end;
+        }
+
+        if(last < first || last >= MAX_CPUS) return false;
+        for(auto cpu = first; cpu <= last; cpu++) out_cpus.set(cpu);
+
+        if(*p == ',') {
+            ++p;
+        } else if(*p != 0 && *p != '\n') {
+            return false;
+        } else {
+            break;
+        }
+    }
+    return true;
+}
+
+/**
+ * \brief Reports the online CPUs
+ *
+ * \return the online CPUs, or CPU 0 only if they cannot be determined
+ */
+inline std::bitset<MAX_CPUS> online_cpus() {
+    std::bitset<MAX_CPUS> cpus;
+    std::string line;
+    if(!read_line("/sys/devices/system/cpu/online", line) || !parse_cpulist(line, cpus) || cpus.none()) {
+        cpus.reset();
+        cpus.set(0);
+    }
+    return cpus;
+}
+
+/**
+ * \brief Reports the CPUs of a NUMA node
+ *
+ * \param node the NUMA node
+ * \param out_cpus receives the CPUs of the node
+ * \return true if the node exists
+ * \return false otherwise
+ */
+inline bool numa_node_cpus(unsigned const node, std::bitset<MAX_CPUS>& out_cpus) {
+    std::string line;
+    out_cpus.reset();
+    return read_line("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist", line) && parse_cpulist(line, out_cpus);
+}
+
+/**
+ * \brief Reports the topological location of a CPU
+ *
+ * \param cpu the CPU
+ * \param out_package receives the physical package (socket) of the CPU
+ * \param out_core receives the core of the CPU within its package
+ */
+inline void cpu_location(unsigned const cpu, unsigned& out_package, unsigned& out_core) {
+    auto const dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+    std::string line;
+    out_package = read_line(dir + "physical_package_id", line) ? unsigned(std::strtoul(line.c_str(), nullptr, 10)) : 0;
+    out_core = read_line(dir + "core_id", line) ? unsigned(std::strtoul(line.c_str(), nullptr, 10)) : cpu;
+}
+
+/**
+ * \brief Removes the annotation of a resolved expression as produced by \ref annotate_expression
+ *
+ * \param s the possibly annotated expression
+ * \return the expression without annotation
+ */
+inline std::string_view strip_annotation(std::string_view s) {
+    auto const open = s.rfind(" (");
+    if(open != std::string_view::npos && s.ends_with(')')) {
+        return s.substr(0, open);
+    } else {
+        return s;
+    }
+}
+
+/**
+ * \brief Annotates an expression with the value it resolved to, e.g., <tt>60%ram (9663676416)</tt>
+ *
+ * \param expr the expression
+ * \param value the resolved value
+ * \return the annotated expression
+ */
+inline std::string annotate_expression(std::string_view expr, uint64_t value) {
+    return std::string(expr).append(" (").append(std::to_string(value)).append(")");
+}
+
+/**
+ * \brief Resolves a memory size expression for the current machine
+ *
+ * Expressions have the form <tt>[PERCENT%]SOURCE</tt>, where the source is one of
+ * \c ram (the total physical memory), \c cgroup-limit (the memory limit of the process's cgroup, see \ref cgroup_memory_limit ),
+ * or \c L1 , \c L2 or \c L3 (the size of the respective CPU cache, see \ref cache_size ).
+ * For example, \c 60%ram resolves to 60 percent of the physical memory.
+ *
+ * \param expr the expression
+ * \param out_v receives the resolved number of bytes
+ * \return true if the expression is valid and could be resolved on this machine
+ * \return false otherwise
+ */
+inline bool resolve_memory_expression(std::string_view expr, uint64_t& out_v) {
+    expr = strip_annotation(expr);
+
+    double percent = 100.0;
+    auto const pct = expr.find('%');
+    if(pct != std::string_view::npos) {
+        std::string const num(expr.substr(0, pct));
+        char* end;
+        percent = std::strtod(num.c_str(), &end);
+        if(num.empty() || *end != 0 || !(percent >= 0.0)) return false;
+        expr = expr.substr(pct + 1);
+    }
+
+    uint64_t base;
+    if(expr == "ram") {
+        base = physical_memory();
+    } else if(expr == "cgroup-limit") {
+        base = cgroup_memory_limit();
+    } else if(expr.length() == 2 && (expr[0] == 'L' || expr[0] == 'l') && expr[1] >= '1' && expr[1] <= '3') {
+        base = cache_size(expr[1] - '0');
+    } else {
+        return false;
+    }
+
+    if(base == 0) return false; // could not be determined on this machine
+
+    // the product must be representable, e.g., 1e30%ram is not
+    auto const bytes = double(base) * percent / 100.0;
+    if(!(bytes < 0x1p64)) return false;
+
+    out_v = uint64_t(bytes);
+    return true;
+}
+
+/**
+ * \brief Resolves a CPU core count expression for the current machine
+ *
+ * Expressions are either \c auto or \c cores , which resolve to the number of available cores (see \ref available_cores ),
+ * or of the form <tt>cores/N</tt> or <tt>cores*N</tt> for a positive integer \c N .
+ * Divisions are rounded down, but the result is at least one.
+ * Multiplications whose result exceeds the range of an \c unsigned \c int are invalid.
+ *
+ * \param expr the expression
+ * \param out_v receives the resolved number of cores
+ * \return true if the expression is valid
+ * \return false otherwise
+ */
+inline bool resolve_cores_expression(std::string_view expr, unsigned& out_v) {
+    expr = strip_annotation(expr);
+
+    if(expr == "auto" || expr == "cores") {
+        out_v = available_cores();
+        return true;
+    } else if(expr.starts_with("cores") && expr.length() > 6 && (expr[5] == '/' || expr[5] == '*')) {
+        // strtoul accepts signs and leading whitespace, and would turn -1 into the largest value
+        std::string const num(expr.substr(6));
+        if(num[0] < '0' || num[0] > '9') return false;
+
+        char* end;
+        auto const n = std::strtoul(num.c_str(), &end, 10);
+        if(*end != 0 || n == 0 || n > std::numeric_limits<unsigned>::max()) return false;
+
+        unsigned const cores = available_cores();
+        if(expr[5] == '/') {
+            out_v = std::max(1U, unsigned(cores / n));
+        } else {
+            if(n > std::numeric_limits<unsigned>::max() / cores) return false;
+            out_v = cores * unsigned(n);
+        }
+        return true;
+    } else {
+        return false;
+    }
+}
+
+}
+
+#endif
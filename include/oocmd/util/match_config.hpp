@@ -1,8 +1,12 @@
 #ifndef _OOCMD_MATCH_CONFIG_HPP
 #define _OOCMD_MATCH_CONFIG_HPP
 
-#include <sstream>
+#include <memory_resource>
+#include <string_view>
+
+#include <oocmd/choice.hpp>
 #include <oocmd/config_object.hpp>
+#include <oocmd/util/arena.hpp>
 
 namespace oocmd {
 
@@ -10,9 +14,10 @@ namespace oocmd {
 // in the process, build a new config JSON consisting only of matched parameters
 // arguments that are identified as parameter values will be discarded from args, so only free arguments remain
 // in the end, matched keys will be removed from the input config
-inline nlohmann::json match_config(ConfigObject const& cfgobj, nlohmann::json& config, std::vector<char const*>& args, bool ignore_unknown_params, std::string const& context, std::vector<std::string>& errors) {
+// temporary data, including error messages, is allocated from the memory resource of the error list
+inline nlohmann::json match_config(ConfigObject const& cfgobj, nlohmann::json& config, std::pmr::vector<char const*>& args, bool ignore_unknown_params, std::string_view context, ErrorList& errors) {
     static constexpr int NO_VALUE = -1;
-    static auto print_error_context = [](std::ostringstream& err, ConfigObject const& x, std::string const& context) {
+    static auto print_error_context = [](std::ostream& err, ConfigObject const& x, std::string_view context) {
         if(!context.empty()) {
             err << "object " << context << " (of type " << x.type_name() << ")";
         } else {
@@ -20,8 +25,15 @@ inline nlohmann::json match_config(ConfigObject const& cfgobj, nlohmann::json& c
         }
     };
 
+    auto sub_context = [&](std::string const& key) {
+        std::pmr::string sub_context(context, errors.get_allocator());
+        if(!sub_context.empty()) sub_context.push_back('.');
+        sub_context.append(key);
+        return sub_context;
+    };
+
     nlohmann::json matched;
-    std::vector<std::string> matched_keys;
+    std::pmr::vector<std::string_view> matched_keys(errors.get_allocator());
 
     for(auto& p : config.items()) {
         auto const& key = p.key();
@@ -38,7 +50,7 @@ inline nlohmann::json match_config(ConfigObject const& cfgobj, nlohmann::json& c
             // before anything, do a few sanity checks
             if(v.is_array() && !param->is_list()) {
                 // TODO: use std::format once GCC supports it...
-                std::ostringstream err;
+                ErrorStream err(std::ios_base::out, errors.get_allocator());
                 err << "configuration parameter \"" << key << "\" for ";
                 print_error_context(err, cfgobj, context);
                 err << " expects a single value, but a list was given";
@@ -47,26 +59,79 @@ inline nlohmann::json match_config(ConfigObject const& cfgobj, nlohmann::json& c
             }
 
             // check what type of parameter we are dealing with
-            if(ObjectParam const* eparam = dynamic_cast<ObjectParam const*>(param)) {
+            if(ChoiceParam const* cparam = dynamic_cast<ChoiceParam const*>(param)) {
+                // this is a choice parameter, determine the chosen type name
+                // it is either assigned directly, or it is stored in the object if any sub parameters were given
+                nlohmann::json sub = nlohmann::json::object();
+                nlohmann::json type_name_value;
+                if(v.is_object()) {
+                    if(v.contains(TYPE_NAME_KEY)) {
+                        type_name_value = v[TYPE_NAME_KEY];
+                        v.erase(TYPE_NAME_KEY);
+                    }
+                } else {
+                    type_name_value = v;
+                }
+
+                int i;
+                std::string type_name;
+                if(type_name_value.is_string()) {
+                    type_name = type_name_value.get<std::string>();
+                } else if(type_name_value.is_number() && (i = type_name_value.get<int>()) != NO_VALUE) {
+                    // it's an index into args, use and discard from args
+                    type_name = args[i];
+                    args[i] = nullptr;
+                } else if(v.is_object()) {
+                    // no type name was given, but sub parameters were; they refer to the current choice
+                    type_name = cparam->object(cfgobj).type_name();
+                } else {
+                    // TODO: use std::format once GCC supports it...
+                    ErrorStream err(std::ios_base::out, errors.get_allocator());
+                    err << "configuration parameter \"" << key << "\" for ";
+                    print_error_context(err, cfgobj, context);
+                    err << " expects a type name, but none was given";
+                    errors.emplace_back(err.str());
+                    continue;
+                }
+
+                auto const choice = cparam->find_choice(cfgobj, type_name);
+                if(choice == ChoiceParam::NONE) {
+                    // TODO: use std::format once GCC supports it...
+                    ErrorStream err(std::ios_base::out, errors.get_allocator());
+                    err << "unknown type \"" << type_name << "\" assigned to configuration parameter \"" << key << "\" for ";
+                    print_error_context(err, cfgobj, context);
+                    err << " (expected " << cparam->value_type_str() << ")";
+                    errors.emplace_back(err.str());
+                    continue;
+                }
+
+                if(v.is_object()) {
+                    // match sub parameters against the chosen type
+                    auto x = cparam->make_choice(choice);
+                    sub = match_config(*x, v, args, ignore_unknown_params, sub_context(key), errors);
+                }
+
+                sub[TYPE_NAME_KEY] = type_name;
+                matched[param->name()] = sub;
+                matched_keys.push_back(key);
+            } else if(ObjectParam const* eparam = dynamic_cast<ObjectParam const*>(param)) {
                 // this is an object parameter
                 // as we are configuring a concrete ConfigObject, we know that it must have been successfully parsed at an earlier point
-                if(v.is_object()) {
-                    // the value is an object, recurse
-                    std::string sub_context;
-                    if(context.empty()) {
-                        sub_context = key;
-                    } else {
-                        // TODO: use std::format once GCC supports it...
-                        std::ostringstream sub_context_builder;
-                        sub_context_builder << context << "." << key;
-                        sub_context = sub_context_builder.str();
+                if(v.is_object() && v.contains(TYPE_NAME_KEY)) {
+                    // a value was assigned to the object along with sub parameters - this is only legal if it is the object's type name
+                    auto const& type_name = v[TYPE_NAME_KEY];
+                    if(type_name.is_string() && type_name.get<std::string>() == eparam->object(cfgobj).type_name()) {
+                        v.erase(TYPE_NAME_KEY);
                     }
+                }
 
-                    matched[param->name()] = match_config(eparam->object(), v, args, ignore_unknown_params, sub_context, errors);
+                if(v.is_object() && !v.contains(TYPE_NAME_KEY)) {
+                    // the value is an object, recurse
+                    matched[param->name()] = match_config(eparam->object(cfgobj), v, args, ignore_unknown_params, sub_context(key), errors);
                     matched_keys.push_back(key);
                 } else {
                     // TODO: use std::format once GCC supports it...
-                    std::ostringstream err;
+                    ErrorStream err(std::ios_base::out, errors.get_allocator());
                     err << "cannot assign a value to object parameter \"" << key << "\" of ";
                     print_error_context(err, cfgobj, context);
                     errors.emplace_back(err.str());
@@ -112,7 +177,7 @@ inline nlohmann::json match_config(ConfigObject const& cfgobj, nlohmann::json& c
                                 args[i] = nullptr;
                             } else {
                                 // TODO: use std::format once GCC supports it...
-                                std::ostringstream err;
+                                ErrorStream err(std::ios_base::out, errors.get_allocator());
                                 err << "array item " << x.key() << " of configuration parameter \"" << key << "\" for ";
                                 print_error_context(err, cfgobj, context);
                                 err << " is of unsupported type " << item.type_name();
@@ -123,7 +188,7 @@ inline nlohmann::json match_config(ConfigObject const& cfgobj, nlohmann::json& c
                         matched_keys.push_back(key);
                     } else {
                         // TODO: use std::format once GCC supports it...
-                        std::ostringstream err;
+                        ErrorStream err(std::ios_base::out, errors.get_allocator());
                         err << "configuration parameter \"" << key << "\" for ";
                         print_error_context(err, cfgobj, context);
                         err << " expects a value, but none was given";
@@ -133,7 +198,7 @@ inline nlohmann::json match_config(ConfigObject const& cfgobj, nlohmann::json& c
             }
         } else if(!ignore_unknown_params) {
             // TODO: use std::format once GCC supports it...
-            std::ostringstream err;
+            ErrorStream err(std::ios_base::out, errors.get_allocator());
             err << "unknown configuration parameter \"" << key << "\" for ";
             print_error_context(err, cfgobj, context);
             errors.emplace_back(err.str());
@@ -143,7 +208,7 @@ inline nlohmann::json match_config(ConfigObject const& cfgobj, nlohmann::json& c
     // erase matched parameters from input config
     if(config.is_object()) {
         for(auto const& key : matched_keys) {
-            config.erase(key);
+            config.erase(std::string(key));
         }
     }
 
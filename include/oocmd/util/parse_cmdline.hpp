@@ -1,7 +1,11 @@
 #ifndef _OOCMD_PARSE_CMDLINE_HPP
 #define _OOCMD_PARSE_CMDLINE_HPP
 
+#include <memory_resource>
+
 #include <nlohmann/json.hpp>
+#include <oocmd/config_param.hpp>
+#include <oocmd/util/arena.hpp>
 #include <oocmd/util/bool_string.hpp>
 
 namespace oocmd {
@@ -14,10 +18,11 @@ struct CmdlineConfig {
     
     // the list of arguments that may either represent parameter values or free arguments
     // this can only be figured out in a context aware pass
-    std::vector<char const*> args;
+    std::pmr::vector<char const*> args;
 };
 
-inline static CmdlineConfig parse_cmdline(int argc, char** argv, std::vector<std::string>& errors) {
+// the list of potential free arguments and error messages are allocated from the memory resource of the error list
+inline static CmdlineConfig parse_cmdline(int argc, char** argv, ErrorList& errors) {
     static constexpr int NO_VALUE = -1;
     static auto set_or_make_list = [](nlohmann::json* obj, auto const& value) {
         if(obj->is_null() || (obj->is_number() && obj->get<int>() == NO_VALUE)) {
@@ -34,7 +39,7 @@ inline static CmdlineConfig parse_cmdline(int argc, char** argv, std::vector<std
 
     nlohmann::json obj;
 
-    std::vector<char const*> args;
+    std::pmr::vector<char const*> args(errors.get_allocator());
     nlohmann::json* current_param = nullptr;
     bool parsed_assignment = false;
 
@@ -78,11 +83,17 @@ inline static CmdlineConfig parse_cmdline(int argc, char** argv, std::vector<std
                             if(v.is_object()) {
                                 // the value is already an object, simply navigate to it
                                 current_obj = &v;
+                            } else if(!v.is_array()) {
+                                // the value may be a type name for the object, keep it as such and navigate into the object
+                                auto sub = nlohmann::json::object();
+                                if(!(v.is_number() && v.get<int>() == NO_VALUE)) sub[TYPE_NAME_KEY] = v;
+                                v = std::move(sub);
+                                current_obj = &v;
                             } else {
                                 // the value is something other than an object - this is not legal
                                 // TODO: use std::format once GCC supports it...
                                 *arg = '.';
-                                std::ostringstream err;
+                                ErrorStream err(std::ios_base::out, errors.get_allocator());
                                 err << "error parsing argument \"" << argv[i] << "\": already assigned a value to alleged parent ";
                                 *arg = 0;
                                 err << "\"" << argv[i] << "\"";
@@ -125,9 +136,7 @@ inline static CmdlineConfig parse_cmdline(int argc, char** argv, std::vector<std
                 if(current_param->is_object()) {
                     // the current parameter is an object, which means that a previous command line argument stated a sub parameter
                     // the only way this can legally be assigned a value is its type name
-                    std::ostringstream err;
-                    err << "error parsing argument \"" << argv[i] << "\": cannot assign value because a sub parameter has already been defined";
-                    errors.emplace_back(err.str());
+                    current_param = &(*current_param)[TYPE_NAME_KEY];
                 }
 
                 if(assign_value) {
@@ -148,7 +157,7 @@ inline static CmdlineConfig parse_cmdline(int argc, char** argv, std::vector<std
                 // do a few sanity checks to aid the user
                 if(string_contains_true(arg) || string_contains_false(arg)) {
                     // TODO: use std::format once GCC supports it...
-                    std::ostringstream err;
+                    ErrorStream err(std::ios_base::out, errors.get_allocator());
                     err << "error parsing argument \"" << arg << "\": in case you are trying to explicitly set a value, use the '=' operator instead, e.g., \"--x=" << arg << "\" instead of \"--x " << arg << "\"";
                     err << " (if you actually have an input file named \"" << arg << "\", please consider using a different file name ...)";
                     errors.emplace_back(err.str());
@@ -161,7 +170,7 @@ inline static CmdlineConfig parse_cmdline(int argc, char** argv, std::vector<std
     }
 
     // done
-    return { obj, args };
+    return { std::move(obj), std::move(args) };
 }
 
 }
@@ -0,0 +1,293 @@
+#ifndef _OOCMD_PROCESS_SETUP_HPP
+#define _OOCMD_PROCESS_SETUP_HPP
+
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include <oocmd/util/enum_table.hpp>
+#include <oocmd/util/machine.hpp>
+#include <oocmd/util/value_traits.hpp>
+
+namespace oocmd {
+
+/**
+ * \brief Transparent huge page modes that can be requested for the process
+ */
+enum class HugePages {
+    inherit, ///< leave the process's transparent huge page setting unchanged
+    always,  ///< enable transparent huge pages for the process
+    madvise, ///< enable transparent huge pages for the process and advise them for the prefaulted heap
+    never    ///< disable transparent huge pages for the process
+};
+
+template<> struct enum_names<HugePages> {
+    static constexpr auto table = make_enum_table<HugePages>({
+        { "inherit", HugePages::inherit }, { "always", HugePages::always }, { "madvise", HugePages::madvise }, { "never", HugePages::never } });
+};
+
+/**
+ * \brief A scheduling policy and priority for the process
+ *
+ * As a config parameter, a scheduling policy is given as one of \c inherit , \c other , \c batch or \c idle ,
+ * or as one of the real-time policies \c fifo or \c rr followed by a colon and the static priority, e.g., <tt>fifo:10</tt> .
+ */
+struct SchedPolicy {
+    static constexpr int INHERIT = -1;
+
+    int policy = INHERIT; ///< the policy as accepted by \c sched_setscheduler , or \ref INHERIT to leave it unchanged
+    int priority = 0;     ///< the static priority, which is only meaningful for real-time policies
+
+    inline bool operator==(SchedPolicy const&) const = default;
+};
+
+// the names of the supported scheduling policies
+inline constexpr std::pair<std::string_view, int> SCHED_POLICIES[] = {
+    { "inherit", SchedPolicy::INHERIT },
+    { "other", SCHED_OTHER },
+    { "batch", SCHED_BATCH },
+    { "idle", SCHED_IDLE },
+    { "fifo", SCHED_FIFO },
+    { "rr", SCHED_RR },
+};
+
+/**
+ * \brief Parses a scheduling policy, e.g., \c batch or <tt>fifo:10</tt>
+ *
+ * \param s the string to parse
+ * \param out_v receives the parsed scheduling policy
+ * \return true if parsing succeeded
+ * \return false otherwise
+ */
+inline bool parse_sched_policy(std::string_view s, SchedPolicy& out_v) {
+    auto const colon = s.find(':');
+    auto const name = s.substr(0, colon);
+
+    for(auto const& [policy_name, policy] : SCHED_POLICIES) {
+        if(name != policy_name) continue;
+
+        bool const realtime = (policy == SCHED_FIFO || policy == SCHED_RR);
+        if(realtime != (colon != std::string_view::npos)) return false; // priorities are given for real-time policies only
+
+        int priority = 0;
+        if(realtime) {
+            auto const num = s.substr(colon + 1);
+            auto const r = std::from_chars(num.data(), num.data() + num.size(), priority);
+            if(num.empty() || r.ec != std::errc() || r.ptr != num.data() + num.size()) return false;
+            if(priority < sched_get_priority_min(policy) || priority > sched_get_priority_max(policy)) return false;
+        }
+
+        out_v.policy = policy;
+        out_v.priority = priority;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * \brief Formats a scheduling policy such that it can be parsed again using \ref parse_sched_policy
+ *
+ * \param v the scheduling policy
+ * \return the formatted scheduling policy
+ */
+inline std::string make_sched_policy_string(SchedPolicy const& v) {
+    for(auto const& [name, policy] : SCHED_POLICIES) {
+        if(policy == v.policy) {
+            std::string s(name);
+            if(policy == SCHED_FIFO || policy == SCHED_RR) s.append(":").append(std::to_string(v.priority));
+            return s;
+        }
+    }
+    return std::to_string(v.policy);
+}
+
+// value traits for scheduling policies
+template<>
+struct value_traits<SchedPolicy> {
+    static bool parse(std::string_view s, SchedPolicy& out_v) { return parse_sched_policy(s, out_v); }
+    static std::string format(SchedPolicy const& v) { return make_sched_policy_string(v); }
+    static std::string type_name() { return "scheduling policy"; }
+};
+
+namespace process {
+
+// formats an error message for a failed system call
+inline std::string system_error(std::string_view what) {
+    return std::string(what).append(": ").append(std::strerror(errno));
+}
+
+/**
+ * \brief Sets the transparent huge page mode of the process
+ *
+ * Enabling huge pages for the process fails if they are disabled system-wide.
+ *
+ * \param mode the requested mode
+ * \param out_error receives an error message in case of failure
+ * \return true if the mode was set
+ * \return false otherwise
+ */
+inline bool set_huge_pages(HugePages const mode, std::string& out_error) {
+    if(mode == HugePages::inherit) return true;
+
+    if(prctl(PR_SET_THP_DISABLE, mode == HugePages::never ? 1 : 0, 0, 0, 0) != 0) {
+        out_error = system_error("failed to set transparent huge page mode");
+        return false;
+    }
+
+    if(mode != HugePages::never) {
+        // the system-wide setting is reported like "always [madvise] never"
+        std::string system;
+        if(machine::read_line("/sys/kernel/mm/transparent_hugepage/enabled", system) && system.find("[never]") != std::string::npos) {
+            out_error = "transparent huge pages are disabled system-wide";
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * \brief Sets the scheduling policy of the process
+ *
+ * \param policy the scheduling policy
+ * \param out_error receives an error message in case of failure
+ * \return true if the policy was set
+ * \return false otherwise
+ */
+inline bool set_sched_policy(SchedPolicy const& policy, std::string& out_error) {
+    if(policy.policy == SchedPolicy::INHERIT) return true;
+
+    sched_param param{};
+    param.sched_priority = policy.priority;
+    if(sched_setscheduler(0, policy.policy, &param) != 0) {
+        out_error = system_error("failed to set scheduling policy " + make_sched_policy_string(policy));
+        return false;
+    }
+    return true;
+}
+
+/**
+ * \brief Adjusts the nice value of the process
+ *
+ * \param increment the value to add to the current nice value
+ * \param out_error receives an error message in case of failure
+ * \return true if the nice value was adjusted
+ * \return false otherwise
+ */
+inline bool adjust_nice(int const increment, std::string& out_error) {
+    if(increment == 0) return true;
+
+    errno = 0;
+    if(nice(increment) == -1 && errno != 0) {
+        out_error = system_error("failed to adjust nice value by " + std::to_string(increment));
+        return false;
+    }
+    return true;
+}
+
+/**
+ * \brief Sets the core dump filter of the process
+ *
+ * \param filter the filter bit mask as a hexadecimal string, or an empty string to leave it unchanged
+ * \param out_error receives an error message in case of failure
+ * \return true if the filter was set
+ * \return false otherwise
+ */
+inline bool set_coredump_filter(std::string const& filter, std::string& out_error) {
+    if(filter.empty()) return true;
+
+    auto const digits = std::string_view(filter).substr(filter.starts_with("0x") ? 2 : 0);
+    unsigned long mask;
+    auto const r = std::from_chars(digits.data(), digits.data() + digits.size(), mask, 16);
+    if(digits.empty() || r.ec != std::errc() || r.ptr != digits.data() + digits.size()) {
+        out_error = "invalid core dump filter \"" + filter + "\", expected a hexadecimal bit mask";
+        return false;
+    }
+
+    std::ofstream f("/proc/self/coredump_filter");
+    if(!(f << std::hex << mask << std::flush)) {
+        out_error = "failed to set core dump filter";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * \brief Pre-faults heap memory
+ *
+ * A block of the given size is allocated and each of its pages is touched before it is released again.
+ * With glibc, the allocator is configured to keep the released memory on the heap rather than returning it to the system,
+ * so that subsequent allocations of up to the given size do not incur page faults.
+ *
+ * \param bytes the number of bytes to pre-fault
+ * \param huge_pages whether to advise transparent huge pages for the pre-faulted memory
+ * \param out_error receives an error message in case of failure
+ * \return true if the memory was pre-faulted
+ * \return false otherwise
+ */
+inline bool prefault(size_t const bytes, bool const huge_pages, std::string& out_error) {
+    if(bytes == 0) return true;
+
+#ifdef __GLIBC__
+    // serve all allocations from the heap and never trim it
+    mallopt(M_MMAP_MAX, 0);
+    mallopt(M_TRIM_THRESHOLD, INT_MAX);
+#endif
+
+    auto* p = static_cast<char*>(std::malloc(bytes));
+    if(!p) {
+        out_error = "failed to allocate " + std::to_string(bytes) + " bytes for pre-faulting";
+        return false;
+    }
+
+    auto const page_size = size_t(sysconf(_SC_PAGESIZE));
+    if(huge_pages) {
+        // advise huge pages for the page-aligned portion of the block
+        auto const begin = (uintptr_t(p) + page_size - 1) & ~(uintptr_t(page_size) - 1);
+        auto const end = (uintptr_t(p) + bytes) & ~(uintptr_t(page_size) - 1);
+        if(end > begin) madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE);
+    }
+
+    for(size_t i = 0; i < bytes; i += page_size) {
+        static_cast<char volatile*>(p)[i] = 0;
+    }
+    std::free(p);
+    return true;
+}
+
+/**
+ * \brief Locks all current and future pages of the process into memory
+ *
+ * \param out_error receives an error message in case of failure
+ * \return true if the memory was locked
+ * \return false otherwise
+ */
+inline bool lock_memory(std::string& out_error) {
+    if(mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        out_error = system_error("failed to lock memory");
+        return false;
+    }
+    return true;
+}
+
+}
+
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef _OOCMD_RATE_HPP
+#define _OOCMD_RATE_HPP
+
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <string_view>
+
+#include <oocmd/util/duration.hpp>
+#include <oocmd/util/si_iec_string.hpp>
+#include <oocmd/util/value_traits.hpp>
+
+namespace oocmd {
+
+/**
+ * \brief A rate, e.g., of operations or bytes, normalized to a number per second
+ *
+ * As a config parameter, rates are given as an SI or IEC formatted number followed by an optional time unit, e.g., \c 10k/s , \c 1.2GiB/s or \c 500/ms .
+ * If no time unit is given, the rate is assumed to be per second.
+ */
+struct Rate {
+    double per_second = 0.0;
+
+    /**
+     * \brief Reports the amount during the given duration at this rate
+     *
+     * \param d the duration
+     * \return the amount during the given duration
+     */
+    template<typename Rep, typename Period>
+    inline double per(std::chrono::duration<Rep, Period> d) const {
+        return per_second * std::chrono::duration<double>(d).count();
+    }
+
+    inline bool operator==(Rate const&) const = default;
+};
+
+/**
+ * \brief Parses a rate string, e.g., \c 10k/s or \c 1.2GiB/s
+ *
+ * \param s the string to parse
+ * \param out_v receives the parsed rate
+ * \return true if parsing succeeded
+ * \return false otherwise
+ */
+inline bool parse_rate(std::string_view s, Rate& out_v) {
+    std::string str(s); // ensure null termination
+    char const* p = str.c_str();
+    while(*p == ' ') ++p;
+    if(*p == '-') return false; // rates are non-negative
+
+    double amount;
+    if(!parse_si_iec_number(p, amount)) return false;
+
+    while(*p == ' ') ++p;
+
+    double per_second = amount;
+    if(*p == '/') {
+        ++p;
+        while(*p == ' ') ++p;
+
+        TimeUnit unit;
+        if(!parse_time_unit(p, unit)) return false;
+        per_second = amount * double(unit.den) / double(unit.num);
+    }
+
+    while(*p == ' ') ++p;
+    if(*p != 0 || !std::isfinite(per_second)) return false; // garbage or overflow
+
+    out_v.per_second = per_second;
+    return true;
+}
+
+/**
+ * \brief Formats a rate such that it can be parsed again using \ref parse_rate
+ *
+ * \param v the rate
+ * \return the formatted rate
+ */
+inline std::string make_rate_string(Rate v) {
+    return make_si_iec_string(v.per_second).append("/s");
+}
+
+// value traits for rates
+template<>
+struct value_traits<Rate> {
+    static bool parse(std::string_view s, Rate& out_v) { return parse_rate(s, out_v); }
+    static std::string format(Rate const& v) { return make_rate_string(v); }
+    static std::string type_name() { return "rate"; }
+};
+
+}
+
+#endif
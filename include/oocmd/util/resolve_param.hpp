@@ -0,0 +1,69 @@
+#ifndef _OOCMD_RESOLVE_PARAM_HPP
+#define _OOCMD_RESOLVE_PARAM_HPP
+
+#include <string_view>
+
+#include <oocmd/choice.hpp>
+#include <oocmd/config_object.hpp>
+
+namespace oocmd {
+
+namespace detail {
+
+// resolves a parameter for a possibly const root object, optionally refusing to descend into objects that do not exist yet
+template<typename Object>
+inline ConfigParam const* resolve_param(Object& root, std::string_view path, Object*& owner, bool const construct) {
+    owner = &root;
+    while(true) {
+        auto const dot = path.find('.');
+        auto const name = path.substr(0, dot);
+
+        auto const* param = owner->get_param(name);
+        if(!param || dot == std::string_view::npos) return param;
+
+        if(auto const* oparam = dynamic_cast<ObjectParam const*>(param)) {
+            if(!construct && !oparam->constructed(*owner)) return nullptr;
+            owner = &oparam->object(*owner);
+        } else if(auto const* cparam = dynamic_cast<ChoiceParam const*>(param)) {
+            owner = &cparam->object(*owner);
+        } else {
+            return nullptr;
+        }
+        path.remove_prefix(dot + 1);
+    }
+}
+
+}
+
+/**
+ * \brief Resolves a parameter by its dot-separated path, descending into nested objects and the selected alternatives of choices
+ *
+ * Descending into a \ref Lazy object constructs it, unless \c construct is false, in which case a path leading through a lazy object that does not exist yet is not resolved.
+ *
+ * \param root the object to start from
+ * \param path the path of the parameter, e.g., <tt>cache.shards</tt>
+ * \param owner receives the object that declares the parameter
+ * \param construct whether to construct lazy objects on the path
+ * \return the parameter, or \c nullptr if the path does not name a parameter
+ */
+inline ConfigParam const* resolve_param(ConfigObject& root, std::string_view path, ConfigObject*& owner, bool const construct = true) {
+    return detail::resolve_param(root, path, owner, construct);
+}
+
+/**
+ * \brief Resolves a parameter by its dot-separated path without modifying any object
+ *
+ * Lazy objects that do not exist yet are never constructed; instead, the path is resolved in their prototype.
+ *
+ * \param root the object to start from
+ * \param path the path of the parameter, e.g., <tt>cache.shards</tt>
+ * \param owner receives the object that declares the parameter
+ * \return the parameter, or \c nullptr if the path does not name a parameter
+ */
+inline ConfigParam const* resolve_param(ConfigObject const& root, std::string_view path, ConfigObject const*& owner) {
+    return detail::resolve_param(root, path, owner, true);
+}
+
+}
+
+#endif
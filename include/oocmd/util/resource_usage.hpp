@@ -0,0 +1,68 @@
+#ifndef _OOCMD_RESOURCE_USAGE_HPP
+#define _OOCMD_RESOURCE_USAGE_HPP
+
+#include <chrono>
+#include <cstdint>
+
+#include <sys/resource.h>
+
+#include <nlohmann/json.hpp>
+
+namespace oocmd {
+
+/**
+ * \brief Resources used by the process during a period of time
+ */
+struct ResourceUsage {
+    double   wall = 0.0;       ///< the elapsed wall-clock time in seconds
+    double   user = 0.0;       ///< the CPU time spent in user mode in seconds
+    double   system = 0.0;     ///< the CPU time spent in kernel mode in seconds
+    uint64_t max_rss = 0;      ///< the maximum resident set size of the process in bytes (since process start, as reported by the system)
+    uint64_t minor_faults = 0; ///< the number of page faults serviced without I/O
+    uint64_t major_faults = 0; ///< the number of page faults that required I/O
+
+    /**
+     * \brief Reports the resource usage as JSON
+     *
+     * \return the resource usage as JSON
+     */
+    inline nlohmann::json to_json() const {
+        return { { "wall", wall }, { "user", user }, { "system", system }, { "max_rss", max_rss }, { "minor_faults", minor_faults }, { "major_faults", major_faults } };
+    }
+};
+
+/**
+ * \brief Measures the resources used by the process while executing a function
+ *
+ * Since CPU time and page faults are accounted for the whole process, the measurement includes any other threads running meanwhile.
+ *
+ * \tparam F the function type
+ * \param f the function
+ * \param out_usage receives the resources used
+ * \return the return value of the function
+ */
+template<typename F>
+auto measure(F&& f, ResourceUsage& out_usage) {
+    static auto seconds = [](timeval const& tv){ return double(tv.tv_sec) + double(tv.tv_usec) * 1e-6; };
+
+    rusage before, after;
+    getrusage(RUSAGE_SELF, &before);
+    auto const t0 = std::chrono::steady_clock::now();
+
+    auto result = f();
+
+    auto const t1 = std::chrono::steady_clock::now();
+    getrusage(RUSAGE_SELF, &after);
+
+    out_usage.wall = std::chrono::duration<double>(t1 - t0).count();
+    out_usage.user = seconds(after.ru_utime) - seconds(before.ru_utime);
+    out_usage.system = seconds(after.ru_stime) - seconds(before.ru_stime);
+    out_usage.max_rss = uint64_t(after.ru_maxrss) * 1024ULL; // reported in kilobytes on Linux
+    out_usage.minor_faults = uint64_t(after.ru_minflt - before.ru_minflt);
+    out_usage.major_faults = uint64_t(after.ru_majflt - before.ru_majflt);
+    return result;
+}
+
+}
+
+#endif
@@ -2,6 +2,8 @@
 #define _OOCMD_SI_IEC_STRING_HPP
 
 #include <cctype>
+#include <charconv>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
@@ -62,6 +64,67 @@ inline bool parse_si_iec_string(std::string const& s, uint64_t& out_v) {
     return parse_si_iec_string(s.data(), out_v);
 }
 
+// parses a (possibly fractional) number followed by an optional SI or IEC prefix and an optional byte indicator
+// the pointer is advanced past the parsed characters, which need not be the end of the string
+inline bool parse_si_iec_number(char const*& p, double& out_v) {
+    static constexpr double SI_BASE = 1000.0;
+    static constexpr double IEC_BASE = 1024.0;
+
+    char* q;
+    out_v = std::strtod(p, &q);
+    if(q == p || !std::isfinite(out_v)) {
+        return false; // could not parse any finite number
+    }
+    p = q;
+
+    while(*p == ' ') ++p; // skip whitespace
+
+    // find power as indicated by first letter
+    int power = 0;
+    switch(std::toupper((unsigned char)*p)) {
+        case 'K': power = 1; break;
+        case 'M': power = 2; break;
+        case 'G': power = 3; break;
+        case 'T': power = 4; break;
+        case 'P': power = 5; break;
+    }
+
+    // if power was given, decide between SI and IEC units
+    double base = SI_BASE; // default to SI
+    if(power != 0) {
+        ++p;
+        if(std::toupper((unsigned char)*p) == 'I') {
+            base = IEC_BASE; // switch to IEC
+            ++p;
+        }
+    }
+
+    // adjust output value
+    out_v *= std::pow(base, power);
+
+    // skip possible byte indicator
+    if(std::toupper((unsigned char)*p) == 'B') {
+        ++p;
+    }
+
+    return std::isfinite(out_v);
+}
+
+inline bool parse_si_iec_string(const char* str, double& out_v) {
+    auto p = str;
+    if(!parse_si_iec_number(p, out_v)) return false;
+
+    // skip over any remaining spaces
+    while(*p == ' ') ++p;
+
+    // report success if end of string was reached
+    return (*p == 0);
+}
+
+inline bool parse_si_iec_string(std::string const& s, double& out_v) {
+    return parse_si_iec_string(s.data(), out_v);
+}
+
 inline std::string make_si_iec_string(uint64_t v) {
     static constexpr uint64_t SI_BASE = 1000;
     static constexpr uint64_t IEC_BASE = 1024;
@@ -93,6 +156,38 @@ inline std::string make_si_iec_string(uint64_t v) {
     }
 }
 
+inline std::string make_si_iec_string(double v) {
+    static constexpr double MAX_EXACT_INTEGER = 9007199254740992.0; // 2^53
+
+    static const std::string SI_UNITS[] = { "", "K", "M", "G", "T", "P" };
+    static const std::string IEC_UNITS[] = { "", "Ki", "Mi", "Gi", "Ti", "Pi" };
+
+    if(v >= 0.0 && v <= MAX_EXACT_INTEGER && v == std::floor(v)) {
+        // integers are formatted exactly
+        return make_si_iec_string((uint64_t)v);
+    }
+
+    // find the shortest representation that parses back to the same value
+    auto shortest = [](double x) {
+        char buf[32];
+        auto const r = std::to_chars(buf, buf + sizeof(buf), x);
+        return std::string(buf, r.ptr);
+    };
+
+    std::string best = shortest(v);
+    for(int power = 1; power <= 5; power++) {
+        for(auto const& [base, units] : { std::pair(1000.0, SI_UNITS), std::pair(1024.0, IEC_UNITS) }) {
+            auto const s = shortest(v / std::pow(base, power)) + units[power];
+
+            double parsed;
+            if(s.length() < best.length() && parse_si_iec_string(s, parsed) && parsed == v) {
+                best = s;
+            }
+        }
+    }
+    return best;
+}
+
 }
 
 #endif
@@ -0,0 +1,81 @@
+#ifndef _OOCMD_STATISTICS_HPP
+#define _OOCMD_STATISTICS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace oocmd {
+
+/**
+ * \brief Robust summary statistics of a series of measurements
+ */
+struct Statistics {
+    size_t count = 0;    ///< the number of measurements
+    double min = 0.0;    ///< the minimum
+    double median = 0.0; ///< the median
+    double mad = 0.0;    ///< the median absolute deviation from the median
+    double p90 = 0.0;    ///< the 90th percentile
+    double p99 = 0.0;    ///< the 99th percentile
+    double max = 0.0;    ///< the maximum
+    double mean = 0.0;   ///< the arithmetic mean
+
+    /**
+     * \brief Reports the statistics as JSON
+     *
+     * \return the statistics as JSON
+     */
+    inline nlohmann::json to_json() const {
+        return { { "count", count }, { "min", min }, { "median", median }, { "mad", mad }, { "p90", p90 }, { "p99", p99 }, { "max", max }, { "mean", mean } };
+    }
+};
+
+/**
+ * \brief Computes the given percentile of a sorted series, interpolating linearly between the closest ranks
+ *
+ * \param sorted the series, sorted in ascending order
+ * \param p the percentile, between 0 and 100
+ * \return the percentile, or zero if the series is empty
+ */
+inline double percentile(std::vector<double> const& sorted, double const p) {
+    if(sorted.empty()) return 0.0;
+
+    auto const rank = std::clamp(p, 0.0, 100.0) / 100.0 * double(sorted.size() - 1);
+    auto const lo = size_t(std::floor(rank));
+    auto const hi = std::min(lo + 1, sorted.size() - 1);
+    return sorted[lo] + (rank - double(lo)) * (sorted[hi] - sorted[lo]);
+}
+
+/**
+ * \brief Computes summary statistics for a series of measurements
+ *
+ * \param values the measurements
+ * \return the summary statistics
+ */
+inline Statistics summarize(std::vector<double> values) {
+    Statistics s;
+    s.count = values.size();
+    if(values.empty()) return s;
+
+    std::sort(values.begin(), values.end());
+    s.min = values.front();
+    s.max = values.back();
+    s.median = percentile(values, 50);
+    s.p90 = percentile(values, 90);
+    s.p99 = percentile(values, 99);
+
+    double sum = 0.0;
+    for(auto const v : values) sum += v;
+    s.mean = sum / double(values.size());
+
+    for(auto& v : values) v = std::abs(v - s.median);
+    std::sort(values.begin(), values.end());
+    s.mad = percentile(values, 50);
+    return s;
+}
+
+}
+
+#endif
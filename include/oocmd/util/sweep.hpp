@@ -0,0 +1,156 @@
+#ifndef _OOCMD_SWEEP_HPP
+#define _OOCMD_SWEEP_HPP
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <oocmd/choice.hpp>
+#include <oocmd/config_object.hpp>
+#include <oocmd/util/arena.hpp>
+
+namespace oocmd {
+
+// a dimension of a parameter sweep, i.e., a parameter that was assigned multiple values
+struct SweepDimension {
+    std::vector<std::string> path;   // the parameter names leading to the parameter in the configuration
+    std::vector<std::string> values; // the values to sweep over
+};
+
+// walk the JSON parsed from the command line and extract sweep dimensions for single-valued parameters that were assigned multiple values
+// values are assigned multiple times either by repeating the parameter, or as a comma-separated list
+// a comma-separated list is only split if the parameter does not accept it as a single string value (e.g., a cpulist), which is tested without assigning it
+// each dimension is replaced by its first value in the input config, so that it can be matched as usual
+inline void extract_sweep(ConfigObject const& cfgobj, nlohmann::json& config, std::pmr::vector<char const*>& args, std::vector<std::string> const& path, std::vector<SweepDimension>& dims, ErrorList& errors) {
+    static constexpr int NO_VALUE = -1;
+
+    if(!config.is_object()) return;
+    for(auto& p : config.items()) {
+        auto const& key = p.key();
+        auto& v = p.value();
+
+        ConfigParam const* param = cfgobj.get_param(key);
+        if(!param && key.length() == 1) param = cfgobj.get_param(key[0]);
+        if(!param || param->is_list() || dynamic_cast<ChoiceParam const*>(param)) continue;
+
+        auto sub_path = path;
+        sub_path.push_back(param->name());
+
+        if(ObjectParam const* oparam = dynamic_cast<ObjectParam const*>(param)) {
+            extract_sweep(oparam->object(cfgobj), v, args, sub_path, dims, errors);
+            continue;
+        }
+
+        // gather the assigned values
+        auto resolve = [&](nlohmann::json const& item, std::string& out_value) {
+            if(item.is_string()) {
+                out_value = item.get<std::string>();
+                return true;
+            } else if(item.is_number() && item.get<int>() != NO_VALUE && !param->is_flag()) {
+                out_value = args[item.get<int>()];
+                return true;
+            }
+            return false;
+        };
+
+        SweepDimension dim;
+        dim.path = sub_path;
+        if(v.is_array()) {
+            for(auto const& item : v) {
+                std::string value;
+                if(!resolve(item, value)) {
+                    // TODO: use std::format once GCC supports it...
+                    ErrorStream err(std::ios_base::out, errors.get_allocator());
+                    err << "cannot sweep over configuration parameter \"" << key << "\": a value is missing";
+                    errors.emplace_back(err.str());
+                    break;
+                }
+                dim.values.push_back(value);
+            }
+        } else {
+            std::string value;
+            if(!resolve(v, value) || value.find(',') == std::string::npos) continue;
+
+            // don't split the list if the parameter accepts it as a single string value (e.g., a cpulist)
+            // numeric parameters are not trusted here, because parsing them may simply stop at the first comma
+            if(param->accepts_as_string(value)) continue;
+
+            std::istringstream list(value);
+            std::string item;
+            while(std::getline(list, item, ',')) dim.values.push_back(item);
+        }
+
+        if(dim.values.size() < 2) continue;
+
+        // consume arguments used as values and replace the values by the first one
+        auto consume = [&](nlohmann::json const& item) {
+            if(item.is_number() && !param->is_flag()) args[item.get<int>()] = nullptr;
+        };
+        if(v.is_array()) {
+            for(auto const& item : v) consume(item);
+        } else {
+            consume(v);
+        }
+        v = dim.values.front();
+
+        dims.push_back(std::move(dim));
+    }
+}
+
+// walk the object tree and gather the dimensions of tunable parameters that are not assigned in the given configuration
+inline void collect_tunables(ConfigObject const& cfgobj, nlohmann::json const& config, std::vector<std::string> const& path, std::vector<SweepDimension>& dims) {
+    for(auto const& [name, domain] : cfgobj.tunables()) {
+        if(domain.empty() || (config.is_object() && config.contains(name))) continue;
+
+        auto sub_path = path;
+        sub_path.push_back(name);
+        dims.push_back({ std::move(sub_path), domain.values() });
+    }
+
+    for(auto const& [key, param] : cfgobj.params()) {
+        if(ObjectParam const* oparam = dynamic_cast<ObjectParam const*>(param)) {
+            auto const& name = oparam->name();
+            auto sub_path = path;
+            sub_path.push_back(name);
+
+            static nlohmann::json const empty = nlohmann::json::object();
+            auto const& sub = (config.is_object() && config.contains(name)) ? config[name] : empty;
+            collect_tunables(oparam->object(cfgobj), sub, sub_path, dims);
+        }
+    }
+}
+
+// computes the configuration for the given point, i.e., assigns the value with the given index in each dimension
+inline nlohmann::json assign_point(nlohmann::json const& matched, std::vector<SweepDimension> const& dims, std::vector<size_t> const& index) {
+    auto point = matched;
+    for(size_t d = 0; d < dims.size(); d++) {
+        auto* v = &point;
+        for(auto const& name : dims[d].path) v = &(*v)[name];
+        *v = dims[d].values[index[d]];
+    }
+    return point;
+}
+
+// computes the configuration for each point of the cartesian product of the given sweep dimensions, the first dimension varying slowest
+inline std::vector<nlohmann::json> sweep_points(nlohmann::json const& matched, std::vector<SweepDimension> const& dims) {
+    std::vector<nlohmann::json> points;
+
+    std::vector<size_t> index(dims.size(), 0);
+    while(true) {
+        points.push_back(assign_point(matched, dims, index));
+
+        // advance to the next point
+        size_t d = dims.size();
+        while(d > 0 && ++index[d - 1] == dims[d - 1].values.size()) {
+            index[d - 1] = 0;
+            --d;
+        }
+        if(d == 0) break;
+    }
+    return points;
+}
+
+}
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef _OOCMD_TOKENIZE_HPP
+#define _OOCMD_TOKENIZE_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace oocmd {
+
+/**
+ * \brief Splits a shell-quoted command line into tokens
+ *
+ * Tokens are separated by whitespace.
+ * Within a token, single quotes preserve everything up to the closing quote literally,
+ * double quotes preserve everything up to the closing quote except for backslash escapes of <tt>"</tt>, <tt>\\</tt>, <tt>$</tt> and <tt>`</tt>,
+ * and a backslash outside of quotes escapes the following character.
+ * No expansions of any kind are performed.
+ *
+ * Tokens that contain no quotes or backslashes are views into the line and are not copied.
+ * Other tokens are unquoted into the given buffer, which is reserved up front so that its views remain valid.
+ *
+ * \param line the command line
+ * \param tokens receives the tokens, which is cleared first
+ * \param buffer the buffer to unquote tokens into, which is cleared first and must not be modified while the tokens are in use
+ * \return true if the line was tokenized successfully
+ * \return false if a quote is not closed or the line ends with a backslash
+ */
+inline bool tokenize_shell(std::string_view const line, std::vector<std::string_view>& tokens, std::string& buffer) {
+    static auto is_space = [](char const c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v'; };
+
+    tokens.clear();
+    buffer.clear();
+    buffer.reserve(line.size()); // unquoting never grows a token, so this prevents reallocation
+
+    size_t i = 0;
+    auto const n = line.size();
+    while(true) {
+        while(i < n && is_space(line[i])) ++i;
+        if(i == n) return true;
+
+        // fast path: a token that does not require unquoting is a view into the line
+        auto const begin = i;
+        while(i < n && !is_space(line[i]) && line[i] != '\'' && line[i] != '"' && line[i] != '\\') ++i;
+        if(i == n || is_space(line[i])) {
+            tokens.push_back(line.substr(begin, i - begin));
+            continue;
+        }
+
+        // slow path: unquote the token into the buffer
+        auto const start = buffer.size();
+        buffer.append(line.substr(begin, i - begin));
+        while(i < n && !is_space(line[i])) {
+            auto const c = line[i++];
+            if(c == '\'') {
+                auto const end = line.find('\'', i);
+                if(end == std::string_view::npos) return false;
+                buffer.append(line.substr(i, end - i));
+                i = end + 1;
+            } else if(c == '"') {
+                while(true) {
+                    if(i == n) return false;
+                    auto const d = line[i++];
+                    if(d == '"') break;
+                    if(d == '\\' && i < n && (line[i] == '"' || line[i] == '\\' || line[i] == '$' || line[i] == '`')) {
+                        buffer.push_back(line[i++]);
+                    } else {
+                        buffer.push_back(d);
+                    }
+                }
+            } else if(c == '\\') {
+                if(i == n) return false;
+                buffer.push_back(line[i++]);
+            } else {
+                buffer.push_back(c);
+            }
+        }
+        tokens.push_back(std::string_view(buffer).substr(start));
+    }
+}
+
+}
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef _OOCMD_TUNING_DOMAIN_HPP
+#define _OOCMD_TUNING_DOMAIN_HPP
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace oocmd {
+
+/**
+ * \brief The finite domain of values that a tunable parameter is searched over
+ *
+ * Values are kept as strings and assigned to the parameter like values given on the command line.
+ */
+class TuningDomain {
+private:
+    std::vector<std::string> values_;
+
+    inline TuningDomain(std::vector<std::string>&& values) : values_(std::move(values)) {
+    }
+
+public:
+    inline TuningDomain() {
+    }
+
+    /**
+     * \brief Constructs a domain consisting of the given values
+     *
+     * \param values the values, e.g., <tt>{ "linear", "quadratic" }</tt>
+     * \return the domain
+     */
+    static inline TuningDomain set(std::vector<std::string> values) {
+        return TuningDomain(std::move(values));
+    }
+
+    /**
+     * \brief Constructs a domain consisting of an arithmetic progression
+     *
+     * \param first the first value
+     * \param last the maximum value
+     * \param step the difference between consecutive values, which must be positive
+     * \return the domain consisting of \c first , <tt>first+step</tt> , ... up to \c last , or an empty domain if \c step is not positive
+     */
+    static inline TuningDomain range(int64_t const first, int64_t const last, int64_t const step = 1) {
+        std::vector<std::string> values;
+        if(step <= 0) return TuningDomain(std::move(values));
+
+        for(auto v = first; v <= last; v += step) {
+            values.push_back(std::to_string(v));
+            if(v > last - step) break; // avoid overflow
+        }
+        return TuningDomain(std::move(values));
+    }
+
+    /**
+     * \brief Constructs a domain consisting of a geometric progression
+     *
+     * \param first the first value, which must be positive
+     * \param last the maximum value
+     * \param factor the ratio between consecutive values, which must be greater than one
+     * \return the domain consisting of \c first , <tt>first*factor</tt> , ... up to \c last , or an empty domain if \c first or \c factor are invalid
+     */
+    static inline TuningDomain log_scale(uint64_t const first, uint64_t const last, uint64_t const factor = 2) {
+        std::vector<std::string> values;
+        if(first == 0 || factor <= 1) return TuningDomain(std::move(values));
+
+        for(auto v = first; v <= last; v *= factor) {
+            values.push_back(std::to_string(v));
+            if(v > last / factor) break; // avoid overflow
+        }
+        return TuningDomain(std::move(values));
+    }
+
+    inline size_t size() const { return values_.size(); }
+    inline bool empty() const { return values_.empty(); }
+    inline std::string const& operator[](size_t const i) const { return values_[i]; }
+    inline std::vector<std::string> const& values() const { return values_; }
+};
+
+}
+
+#endif
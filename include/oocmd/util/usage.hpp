@@ -3,6 +3,7 @@
 
 #include <iostream>
 
+#include <oocmd/choice.hpp>
 #include <oocmd/config_object.hpp>
 
 namespace oocmd {
@@ -26,6 +27,7 @@ inline void print_usage(std::ostream& out, ConfigObject const& e, std::string co
 
     std::vector<ConfigParam const*> group;
     std::vector<ObjectParam const*> nested;
+    std::vector<ChoiceParam const*> choices;
 
     // gather immediate (non-object) params into a local group
     for(auto const& it : e.params()) {
@@ -35,12 +37,16 @@ inline void print_usage(std::ostream& out, ConfigObject const& e, std::string co
             nested.push_back(eparam);
         } else {
             group.push_back(&p);
+
+            auto const* cparam = dynamic_cast<ChoiceParam const*>(&p);
+            if(cparam) choices.push_back(cparam);
         }
     }
 
     // sort params by name
     std::sort(group.begin(), group.end(), compare_by_name);
     std::sort(nested.begin(), nested.end(), compare_by_name);
+    std::sort(choices.begin(), choices.end(), compare_by_name);
 
     // determine indentation of right column
     size_t rindent = 0;
@@ -71,16 +77,30 @@ inline void print_usage(std::ostream& out, ConfigObject const& e, std::string co
 
         while(i++ < rindent) out << " ";
         out << p->description();
-        out << " (" << p->value_type_str() << ", default: " << p->default_value_str()  << ")";
+        out << " (" << p->value_type_str() << ", default: " << p->default_value_str();
+        if(p->is_live()) out << ", live";
+        if(auto const source = e.provenance(p->name()); !source.empty()) out << ", set by " << source;
+        out << ")";
         out << std::endl;
     }
     out << std::endl;
 
     // handle nested objects
     for(auto eparam : nested) {
-        auto const& e = eparam->object();
-        out << "Options for " << eparam->name() << " -- " << eparam->description() << " (" << e.type_name() << " -- " << e.description() << ")" << std::endl;
-        print_usage(out, e, prefix + eparam->name() + ".");
+        auto const& sub = eparam->object(e);
+        out << "Options for " << eparam->name() << " -- " << eparam->description() << " (" << sub.type_name() << " -- " << sub.description() << ")" << std::endl;
+        print_usage(out, sub, prefix + eparam->name() + ".");
+    }
+
+    // handle the alternatives of choices
+    for(auto cparam : choices) {
+        for(size_t i = 0; i < cparam->num_choices(); i++) {
+            auto const x = cparam->make_choice(i);
+            if(!x->params().empty()) {
+                out << "Options for " << cparam->name() << "=" << x->type_name() << " -- " << cparam->description() << " (" << x->type_name() << " -- " << x->description() << ")" << std::endl;
+                print_usage(out, *x, prefix + cparam->name() + ".");
+            }
+        }
     }
 }
 
@@ -0,0 +1,102 @@
+#ifndef _OOCMD_VALUE_TRAITS_HPP
+#define _OOCMD_VALUE_TRAITS_HPP
+
+#include <charconv>
+#include <climits>
+#include <concepts>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <nlohmann/json.hpp>
+#include <oocmd/util/enum_table.hpp>
+
+namespace oocmd {
+
+/**
+ * \brief Customization point for binding arbitrary value types to config parameters
+ *
+ * Any type \c T for which this template is specialized can be bound to a config parameter using \ref ConfigObject::param .
+ * Specializations must provide the following static functions:
+ * - <tt>bool parse(std::string_view s, T& out_v)</tt> attempts to parse the given string into a value and reports whether successful,
+ * - <tt>std::string format(T const& v)</tt> formats a value as a string such that it can be parsed again, and
+ * - <tt>std::string type_name()</tt> describes the type for display in a help screen.
+ *
+ * Optionally, a specialization may provide <tt>nlohmann::json to_json(T const& v)</tt> in order to report values in a configuration as anything other than the formatted string.
+ *
+ * The library provides specializations for all integer types as well as for enumerations with an \ref enum_names specialization.
+ *
+ * \tparam T the value type
+ */
+template<typename T>
+struct value_traits;
+
+/**
+ * \brief Requires a type to have a \ref value_traits specialization
+ *
+ * \tparam T the type
+ */
+template<typename T>
+concept HasValueTraits = std::semiregular<T> && requires(std::string_view s, T& v) {
+    { value_traits<T>::parse(s, v) } -> std::same_as<bool>;
+    { value_traits<T>::format(v) } -> std::convertible_to<std::string>;
+    { value_traits<T>::type_name() } -> std::convertible_to<std::string>;
+};
+
+/**
+ * \brief Converts a value to JSON using its \ref value_traits
+ *
+ * \tparam T the value type
+ * \param v the value
+ * \return the value as JSON
+ */
+template<HasValueTraits T>
+inline nlohmann::json value_to_json(T const& v) {
+    if constexpr(requires { { value_traits<T>::to_json(v) } -> std::convertible_to<nlohmann::json>; }) {
+        return value_traits<T>::to_json(v);
+    } else {
+        return value_traits<T>::format(v);
+    }
+}
+
+// value traits for integers of any width
+template<typename T>
+requires std::integral<T> && (!std::same_as<T, bool>)
+struct value_traits<T> {
+    static bool parse(std::string_view s, T& out_v) {
+        auto const end = s.data() + s.size();
+        auto const r = std::from_chars(s.data(), end, out_v);
+        return r.ec == std::errc() && r.ptr == end;
+    }
+
+    static std::string format(T const& v) { return std::to_string(v); }
+    static nlohmann::json to_json(T const& v) { return v; }
+
+    static std::string type_name() {
+        return std::to_string(sizeof(T) * CHAR_BIT) + (std::is_signed_v<T> ? "-bit integer" : "-bit non-negative integer");
+    }
+};
+
+// value traits for enumerations with names
+template<NamedEnum E>
+struct value_traits<E> {
+    static constexpr auto const& table = enum_names<E>::table;
+
+    static bool parse(std::string_view s, E& out_v) { return table.find(s, out_v); }
+    static std::string format(E const& v) { return std::string(table.name(v)); }
+
+    static std::string type_name() {
+        std::string s = "one of ";
+        bool first = true;
+        for(auto const& e : table.entries()) {
+            if(!first) s.append(", ");
+            s.append(e.first);
+            first = false;
+        }
+        return s;
+    }
+};
+
+}
+
+#endif
@@ -3,21 +3,51 @@
 
 #include <oocmd.hpp>
 
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace oocmd::test {
+
+enum class Mode { fast, safe, paranoid };
+
+}
+
+template<> struct oocmd::enum_names<oocmd::test::Mode> {
+    using Mode = oocmd::test::Mode;
+    static constexpr auto table = make_enum_table<Mode>({ { "fast", Mode::fast }, { "safe", Mode::safe }, { "paranoid", Mode::paranoid } });
+};
+
 namespace oocmd::test {
 
 using namespace oocmd;
 
+std::vector<char*> make_argv(std::vector<std::string>& v) {
+    std::vector<char*> argv;
+    for(auto& arg : v) argv.push_back(arg.data());
+    return argv;
+}
+
 Application parse(ConfigObject& e, std::vector<std::string>& v) {
-    char** args = new char*[v.size()];
-    for(size_t i = 0; i < v.size(); i++) {
-        args[i] = v[i].data();
-    }
+    auto argv = make_argv(v);
+    return Application(e, (int)argv.size(), argv.data());
+}
+
+template<typename T>
+int run(std::vector<std::string> v) {
+    auto argv = make_argv(v);
+    return Application::run<T>((int)argv.size(), argv.data());
+}
 
-    auto app = Application(e, (int)v.size(), args);
-    delete[] args;
-    return app;
+template<typename T>
+int run(T& x, std::vector<std::string> v) {
+    auto argv = make_argv(v);
+    return Application::run(x, (int)argv.size(), argv.data());
 }
 
 class A : public ConfigObject {
@@ -40,6 +70,7 @@ public:
     double                   double_param_ = 0.0;
     std::string              string_param_;
     std::vector<std::string> stringlist_param_;
+    Mode                     enum_param_ = Mode::safe;
     T                        object_param_;
 
     Test() : ConfigObject("Test", "A test executable") {
@@ -51,10 +82,319 @@ public:
         param("double", double_param_);
         param("string", string_param_);
         param("stringlist", stringlist_param_);
+        param("enum", enum_param_);
         param("object", object_param_);
     }
 };
 
+class HashA : public ConfigObject {
+public:
+    double load_ = 0.5;
+
+    HashA() : ConfigObject("HashA", "Hash table A") {
+        param("load", load_);
+    }
+};
+
+class HashB : public ConfigObject {
+public:
+    double load_ = 0.75;
+    int probes_ = 1;
+
+    HashB() : ConfigObject("HashB", "Hash table B") {
+        param("load", load_);
+        param("probes", probes_);
+    }
+};
+
+class Dispatch : public ConfigObject {
+public:
+    Choice<HashA, HashB> table_;
+
+    Dispatch() : ConfigObject("Dispatch", "A dispatching executable") {
+        param("table", table_);
+    }
+
+    Choice<HashA, HashB>& dispatch() { return table_; }
+
+    template<typename Table>
+    int run(Application const&, Table& table) {
+        if constexpr(std::is_same_v<Table, HashA>) {
+            return 1;
+        } else {
+            return 2 + table.probes_;
+        }
+    }
+};
+
+class Blocked : public ConfigObject {
+public:
+    Specialized<64U, 128U, 256U> block_;
+
+    Blocked() : ConfigObject("Blocked", "A blocked executable") {
+        param('b', "block", block_);
+    }
+
+    Specialized<64U, 128U, 256U>& dispatch() { return block_; }
+
+    template<unsigned int block>
+    int run(Application const&, std::integral_constant<unsigned int, block>) { return block; }
+
+    int run(Application const&, unsigned int block) { return -(int)block; }
+};
+
+class Sweep : public ConfigObject {
+public:
+    int a_ = 0;
+    unsigned int b_ = 0;
+    std::string s_;
+
+    Sweep() : ConfigObject("Sweep", "A swept executable") {
+        param("a", a_);
+        param("b", b_);
+        param("s", s_);
+    }
+
+    int run(Application const&) { return (a_ == 2 && b_ == 20) ? 7 : 0; }
+};
+
+class Measured : public ConfigObject {
+public:
+    int a_ = 0;
+    std::string s_ = "x y";
+    A object_;
+
+    Measured() : ConfigObject("Measured", "A measured executable") {
+        param("a", a_);
+        param("s", s_);
+        param("object", object_);
+    }
+
+    int run(Application const& app) {
+        app.record("square", a_ * a_);
+        app.record("label", "a,b");
+        return 0;
+    }
+};
+
+class Tuned : public ConfigObject {
+public:
+    unsigned int block_ = 1;
+    int offset_ = 0;
+    A object_;
+
+    Tuned() : ConfigObject("Tuned", "A tuned executable") {
+        param("block", block_);
+        param("offset", offset_);
+        param("object", object_);
+        tunable("block", TuningDomain::log_scale(1, 256));
+        tunable("offset", TuningDomain::range(-3, 3));
+    }
+
+    int run(Application const& app) {
+        app.record("cost", std::abs(int(block_) - 16) + std::abs(offset_ - 1) + (object_.x_ ? 0 : 1));
+        return 0;
+    }
+};
+
+class Heavy : public ConfigObject {
+public:
+    static inline int instances = 0;
+
+    int size_ = 1;
+
+    Heavy() : ConfigObject("Heavy", "A heavy object") {
+        param("size", size_);
+        ++instances;
+    }
+};
+
+class WithLazy : public ConfigObject {
+public:
+    Lazy<Heavy> heavy_;
+
+    WithLazy() : ConfigObject("WithLazy", "An object with a lazy member") {
+        param("heavy", heavy_);
+    }
+};
+
+class Extended : public A {
+public:
+    int y_ = 7;
+
+    Extended() {
+        param("y", y_);
+    }
+};
+
+class Fragile : public ConfigObject {
+public:
+    int a_ = 0;
+    int b_ = 0;
+
+    Fragile(bool const fail = false) : ConfigObject("Fragile", "An object whose construction may fail") {
+        param("a", a_);
+        if(fail) throw std::runtime_error("construction failed");
+        param("b", b_);
+    }
+};
+
+class Preset : public ConfigObject {
+public:
+    int w_;
+
+    Preset(int const w = 0) : ConfigObject("Preset", "An object whose defaults depend on its construction"), w_(w) {
+        param("w", w_);
+    }
+};
+
+class Job : public ConfigObject {
+public:
+    int n_ = 0;
+    std::string s_;
+
+    Job() : ConfigObject("Job", "A batch job") {
+        param("n", n_);
+        param("s", s_);
+    }
+
+    int run(Application const& app) {
+        if(n_ < 0) throw std::runtime_error("negative job");
+        app.out() << s_ << ":" << n_ * n_;
+        for(auto const& arg : app.args()) app.out() << " " << arg;
+        return n_ == 3 ? 5 : 0;
+    }
+};
+
+class Async : public ConfigObject {
+public:
+    int n_ = 3;
+
+    Async() : ConfigObject("Async", "An asynchronous executable") {
+        param("n", n_);
+    }
+
+    Task<> produce(EventLoop& loop, int const fd) {
+        for(int i = 1; i <= n_; i++) {
+            co_await loop.sleep_for(std::chrono::milliseconds(1));
+            char const c = char('0' + i);
+            co_await loop.write(fd, &c, 1);
+        }
+        ::close(fd);
+    }
+
+    Task<int> run(Application const& app) {
+        int fds[2];
+        if(pipe2(fds, O_NONBLOCK) != 0) co_return -1;
+
+        auto& loop = app.loop();
+        loop.spawn(produce(loop, fds[1]));
+
+        // sum the digits received until the producer closes the pipe
+        int sum = 0;
+        char buffer[16];
+        while(true) {
+            auto const n = co_await loop.read(fds[0], buffer, sizeof(buffer));
+            if(n <= 0) break;
+            for(ssize_t i = 0; i < n; i++) sum += buffer[i] - '0';
+        }
+        ::close(fds[0]);
+        co_return sum;
+    }
+};
+
+class Stalled : public ConfigObject {
+public:
+    Stalled() : ConfigObject("Stalled", "An asynchronous executable that never completes") {
+    }
+
+    Task<int> run(Application const& app) {
+        co_await std::suspend_always();
+        (void)app;
+        co_return 0;
+    }
+};
+
+class Throwing : public ConfigObject {
+public:
+    Throwing() : ConfigObject("Throwing", "An asynchronous executable whose spawned task fails") {
+    }
+
+    Task<> fail(EventLoop& loop) {
+        co_await loop.yield();
+        throw std::runtime_error("spawned task failed");
+    }
+
+    Task<int> run(Application const& app) {
+        auto& loop = app.loop();
+        loop.spawn(fail(loop));
+        co_await loop.sleep_for(std::chrono::seconds(10));
+        co_return 0;
+    }
+};
+
+class Live : public ConfigObject {
+public:
+    std::atomic<unsigned int> shards_ = 4;
+    std::atomic<bool> verbose_ = false;
+    std::atomic<double> ratio_ = 0.5;
+    int fixed_ = 1;
+    A object_;
+
+    std::vector<std::string> responses_;
+
+    Live() : ConfigObject("Live", "An executable with live parameters") {
+        param("shards", shards_, "The number of shards.");
+        param('v', "verbose", verbose_);
+        param("ratio", ratio_);
+        param("fixed", fixed_);
+        param("object", object_);
+    }
+
+    // sends commands to the control socket and collects the responses
+    int run(Application const& app) {
+        int const fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strcpy(addr.sun_path, app.options().control.c_str());
+        if(connect(fd, reinterpret_cast<sockaddr const*>(&addr), sizeof(addr)) != 0) return -1;
+
+        std::string const commands = "get shards\nset shards=16\n\nset ratio=0.25\nset verbose=on\nset fixed=2\nset shards=x\nget object.x\nfrob\ndiff-from-defaults\n";
+        if(::write(fd, commands.data(), commands.size()) != ssize_t(commands.size())) return -1;
+        shutdown(fd, SHUT_WR);
+
+        std::string received;
+        char buffer[256];
+        ssize_t n;
+        while((n = ::read(fd, buffer, sizeof(buffer))) > 0) received.append(buffer, size_t(n));
+        ::close(fd);
+
+        std::istringstream lines(received);
+        std::string line;
+        while(std::getline(lines, line)) responses_.push_back(line);
+        return shards_.load(std::memory_order_relaxed);
+    }
+};
+
+class Profiled : public ConfigObject {
+public:
+    int n_ = 3;
+
+    Profiled() : ConfigObject("Profiled", "A profiled executable") {
+        param("n", n_);
+    }
+
+    int run(Application const& app) {
+        auto& profiler = app.profiler();
+        auto load = profiler.phase("load");
+        for(int i = 0; i < n_; i++) {
+            auto query = profiler.phase("query");
+            profiler.count("items", 2);
+        }
+        return 0;
+    }
+};
+
 TEST_SUITE("application") {
     TEST_CASE("Command-line defaults") {
         std::vector<std::string> args = { "<PATH>"};
@@ -70,6 +410,7 @@ TEST_SUITE("application") {
         CHECK(a.double_param_ == 0.0);
         CHECK(a.string_param_ == "");
         CHECK(a.stringlist_param_.empty());
+        CHECK(a.enum_param_ == Mode::safe);
         CHECK(!a.object_param_.x_);
         CHECK(app.args().empty());
     }
@@ -106,6 +447,266 @@ TEST_SUITE("application") {
         CHECK(app.args()[0] == "FREE");
     }
 
+    TEST_CASE("Enum configuration") {
+        {
+            std::vector<std::string> args = { "<PATH>", "--enum=paranoid" };
+            Test<A> a;
+            auto app = parse(a, args);
+
+            REQUIRE(app.good());
+            CHECK(a.enum_param_ == Mode::paranoid);
+            CHECK(a.config()["enum"] == "paranoid");
+        }
+        {
+            std::vector<std::string> args = { "<PATH>", "--enum", "fastest" };
+            Test<A> a;
+            auto app = parse(a, args);
+
+            CHECK(a.enum_param_ == Mode::safe);
+        }
+    }
+
+    TEST_CASE("Value traits configuration") {
+        struct Ints : public ConfigObject {
+            int8_t   i8 = 0;
+            uint16_t u16 = 0;
+            int64_t  i64 = 0;
+            size_t   size = 0;
+
+            Ints() : ConfigObject("Ints", "Fixed-width integers") {
+                param("i8", i8);
+                param("u16", u16);
+                param("i64", i64);
+                param("size", size);
+            }
+        };
+
+        {
+            std::vector<std::string> args = { "<PATH>", "--i8=-100", "--u16=65535", "--i64=-9000000000", "--size=1Ki" };
+            Ints x;
+            auto app = parse(x, args);
+
+            REQUIRE(app.good());
+            CHECK(x.i8 == -100);
+            CHECK(x.u16 == 65535);
+            CHECK(x.i64 == -9000000000LL);
+            CHECK(x.size == 1024);
+            CHECK(x.config()["i64"] == -9000000000LL);
+        }
+        {
+            std::vector<std::string> args = { "<PATH>", "--i8=300", "--u16=-1" };
+            Ints x;
+            auto app = parse(x, args);
+
+            CHECK(x.i8 == 0);
+            CHECK(x.u16 == 0);
+        }
+    }
+
+    TEST_CASE("Duration and rate configuration") {
+        struct Timing : public ConfigObject {
+            std::chrono::microseconds     timeout{0};
+            std::chrono::seconds          interval{10};
+            std::chrono::duration<double> window{0.5};
+            Rate                          limit;
+            Rate                          bandwidth;
+
+            Timing() : ConfigObject("Timing", "Durations and rates") {
+                param("timeout", timeout);
+                param("interval", interval);
+                param("window", window);
+                param("limit", limit);
+                param("bandwidth", bandwidth);
+            }
+        };
+
+        {
+            std::vector<std::string> args = { "<PATH>", "--timeout=1.5ms", "--interval=2m", "--window=250us", "--limit=10k/s", "--bandwidth=1.2GiB/s" };
+            Timing x;
+            auto app = parse(x, args);
+
+            REQUIRE(app.good());
+            CHECK(x.timeout.count() == 1500);
+            CHECK(x.interval.count() == 120);
+            CHECK(x.window.count() == doctest::Approx(0.00025));
+            CHECK(x.limit.per_second == 10000.0);
+            CHECK(x.bandwidth.per_second == doctest::Approx(1.2 * 1024 * 1024 * 1024));
+
+            auto const cfg = x.config();
+            CHECK(cfg["timeout"] == "1500us");
+            CHECK(cfg["interval"] == "2min");
+            CHECK(cfg["limit"] == "10K/s");
+            CHECK(cfg["bandwidth"] == "1.2Gi/s");
+        }
+        {
+            std::vector<std::string> args = { "<PATH>", "--interval=1.5s", "--timeout=10000000000000d", "--limit=5/ms" };
+            Timing x;
+            auto app = parse(x, args);
+
+            CHECK(x.interval.count() == 10); // not representable
+            CHECK(x.timeout.count() == 0);   // overflow
+            CHECK(x.limit.per_second == 5000.0);
+        }
+    }
+
+    TEST_CASE("Machine-aware configuration") {
+        std::vector<std::string> args = { "<PATH>", "--uint=cores/2", "--bytes=50%ram" };
+        Test<A> a;
+        auto app = parse(a, args);
+
+        REQUIRE(app.good());
+        CHECK(a.uint_param_ == std::max(1U, machine::available_cores() / 2));
+        CHECK(a.bytes_param_ == machine::physical_memory() / 2);
+
+        auto const cfg = a.config();
+        CHECK(cfg["uint"] == "cores/2 (" + std::to_string(a.uint_param_) + ")");
+        CHECK(cfg["bytes"] == "50%ram (" + std::to_string(a.bytes_param_) + ")");
+
+        // configuring from the reported configuration resolves the expressions again
+        Test<A> b;
+        b.configure(cfg);
+        CHECK(b.uint_param_ == a.uint_param_);
+        CHECK(b.bytes_param_ == a.bytes_param_);
+
+        // negative factors and unrepresentable results are rejected
+        unsigned cores;
+        uint64_t bytes;
+        CHECK(!machine::resolve_cores_expression("cores*-1", cores));
+        CHECK(!machine::resolve_cores_expression("cores/ 2", cores));
+        CHECK(!machine::resolve_cores_expression("cores*99999999999", cores));
+        CHECK(!machine::resolve_memory_expression("1e30%ram", bytes));
+        CHECK(machine::resolve_memory_expression("200%ram", bytes));
+    }
+
+    TEST_CASE("CPU set configuration") {
+        struct Pinned : public ConfigObject {
+            CpuSet    cpus;
+            Placement placement = Placement::compact;
+
+            Pinned() : ConfigObject("Pinned", "CPU sets") {
+                param("cpus", cpus);
+                param("placement", placement);
+            }
+        };
+
+        auto const online = CpuSet::online();
+        auto const first = online.list().front();
+        {
+            std::vector<std::string> args = { "<PATH>", "--cpus=" + std::to_string(first), "--placement=scatter" };
+            Pinned x;
+            auto app = parse(x, args);
+
+            REQUIRE(app.good());
+            CHECK(x.cpus.size() == 1);
+            CHECK(x.cpus.contains(first));
+            CHECK(x.placement == Placement::scatter);
+            CHECK(x.cpus.plan(3, x.placement) == std::vector<unsigned>(3, first));
+            CHECK(x.config()["cpus"] == std::to_string(first));
+        }
+        {
+            // comma-separated lists are tested without assigning them to decide whether to sweep over them
+            Pinned x;
+            CHECK(x.get_param("cpus")->accepts_as_string(std::to_string(first) + "," + std::to_string(first)));
+            CHECK(!x.get_param("placement")->accepts_as_string("compact,scatter"));
+            CHECK(!x.get_param("cpus")->accepts_as_string(std::to_string(first) + ",!" + std::to_string(first)));
+            CHECK(!x.get_param("cpus")->accepts_as_string("!all"));
+            CHECK(x.cpus.empty());
+
+            std::vector<std::string> args = { "<PATH>", "--oocmd.sweep", "--oocmd.sweep_output=/dev/null", "--cpus=" + std::to_string(first) + "," + std::to_string(first), "--placement=compact,scatter" };
+            auto app = parse(x, args);
+            REQUIRE(app.good());
+            CHECK(x.placement == Placement::compact);
+        }
+        {
+            std::vector<std::string> args = { "<PATH>", "--cpus=node:0,!" + std::to_string(first) };
+            Pinned x;
+            auto app = parse(x, args);
+
+            REQUIRE(app.good());
+            CHECK(!x.cpus.contains(first));
+            CHECK(x.cpus.size() < online.size());
+        }
+        {
+            std::vector<std::string> args = { "<PATH>", "--cpus=1023" };
+            Pinned x;
+            auto app = parse(x, args);
+
+            CHECK(x.cpus.empty()); // not online
+            CHECK(x.cpus.plan(online.size()).size() == online.size());
+        }
+    }
+
+    TEST_CASE("Thread pool") {
+        std::vector<std::string> args = { "<PATH>", "--oocmd.threads=3" };
+        A a;
+        auto app = parse(a, args);
+
+        REQUIRE(app.good());
+        auto& pool = app.pool();
+        CHECK(pool.size() == 3);
+
+        std::atomic<size_t> sum = 0;
+        pool.parallel_for(0, 1000, [&](size_t i){
+            pool.parallel_for(0, 10, [&](size_t j){ sum += i * 10 + j; });
+        });
+        CHECK(sum == 10000 * 9999 / 2);
+
+        std::atomic<size_t> count = 0;
+        for(size_t i = 0; i < 100; i++) pool.submit([&]{ ++count; });
+        pool.wait();
+        CHECK(count == 100);
+
+        // exceptions escaping tasks are rethrown when waiting
+        count = 0;
+        for(size_t i = 0; i < 10; i++) pool.submit([&, i]{ if(i == 5) throw std::runtime_error("task"); ++count; });
+        CHECK_THROWS_AS(pool.wait(), std::runtime_error);
+        CHECK(count == 9);
+        CHECK_NOTHROW(pool.wait());
+        CHECK_THROWS_AS(pool.parallel_for(0, 100, [](size_t i){ if(i == 42) throw std::runtime_error("index"); }), std::runtime_error);
+
+        uint64_t tasks = 0;
+        for(auto const& s : pool.stats()) tasks += s.tasks;
+        CHECK(tasks <= 100 + 10 + 1000 * 10 + 1000 + 100);
+
+        // independent applications have their own pools
+        A b;
+        auto other = parse(b, args);
+        CHECK(&other.pool() != &pool);
+    }
+
+    TEST_CASE("Process setup") {
+        {
+            std::vector<std::string> args = { "<PATH>", "--oocmd.prefault=1Mi", "--oocmd.thp=inherit", "--oocmd.sched=inherit" };
+            A a;
+            auto app = parse(a, args);
+            REQUIRE(app.good());
+            CHECK(app.options().prefault == 1024 * 1024);
+        }
+        {
+            SchedPolicy policy;
+            CHECK(parse_sched_policy("fifo:10", policy));
+            CHECK(policy.policy == SCHED_FIFO);
+            CHECK(policy.priority == 10);
+            CHECK(make_sched_policy_string(policy) == "fifo:10");
+            CHECK(parse_sched_policy("batch", policy));
+            CHECK(policy.policy == SCHED_BATCH);
+            CHECK(!parse_sched_policy("fifo", policy));
+            CHECK(!parse_sched_policy("batch:1", policy));
+            CHECK(!parse_sched_policy("fifo:1000", policy));
+        }
+        {
+            std::vector<std::string> args = { "<PATH>", "--oocmd.sched=fifo" };
+            A a;
+            auto app = parse(a, args);
+            CHECK(app.options().sched.policy == SchedPolicy::INHERIT);
+        }
+        {
+            std::vector<std::string> args = { "<PATH>", "--oocmd.coredump_filter=xyz" };
+            A a;
+            CHECK(!parse(a, args).good());
+        }
+    }
+
     TEST_CASE("Command-line configuration, alternative syntax") {
         std::vector<std::string> args = { "<PATH>", "--bool=1", "--int=-5", "--uint=5", "--bytes=1Ki", "--float=-.5", "--double=777.77", "--string=test", "--stringlist=X", "--stringlist=Y", "--object.x", "FREE" };
         Test<A> a;
@@ -125,6 +726,789 @@ TEST_SUITE("application") {
         CHECK(a.object_param_.x_);
         CHECK(app.args()[0] == "FREE");
     }
+
+    TEST_CASE("Choice configuration") {
+        {
+            std::vector<std::string> args = { "<PATH>" };
+            Dispatch d;
+            auto app = parse(d, args);
+
+            REQUIRE(app.good());
+            CHECK(d.table_.holds<HashA>());
+        }
+        {
+            std::vector<std::string> args = { "<PATH>", "--table=HashB", "--table.load=0.9" };
+            Dispatch d;
+            auto app = parse(d, args);
+
+            REQUIRE(app.good());
+            REQUIRE(d.table_.holds<HashB>());
+            CHECK(d.table_.get<HashB>().load_ == 0.9);
+        }
+        {
+            std::vector<std::string> args = { "<PATH>", "--table.probes=3", "--table", "HashB", "FREE" };
+            Dispatch d;
+            auto app = parse(d, args);
+
+            REQUIRE(app.good());
+            REQUIRE(d.table_.holds<HashB>());
+            CHECK(d.table_.get<HashB>().probes_ == 3);
+            CHECK(d.config()["table"][TYPE_NAME_KEY] == "HashB");
+            CHECK(app.args().size() == 1);
+        }
+        {
+            std::vector<std::string> args = { "<PATH>", "--table.load=0.1" };
+            Dispatch d;
+            auto app = parse(d, args);
+
+            REQUIRE(app.good());
+            REQUIRE(d.table_.holds<HashA>());
+            CHECK(d.table_.get<HashA>().load_ == 0.1);
+        }
+        {
+            std::vector<std::string> args = { "<PATH>", "--table=HashC" };
+            Dispatch d;
+            auto app = parse(d, args);
+
+            CHECK(!app.good());
+        }
+    }
+
+    TEST_CASE("Choice dispatch") {
+        std::vector<std::string> args = { "<PATH>", "--table=HashB", "--table.probes=3" };
+        Dispatch d;
+        CHECK(run(d, args) == 5);
+    }
+
+    TEST_CASE("Parameter sweep") {
+        auto const path = std::filesystem::temp_directory_path() / "oocmd-test-sweep.jsonl";
+        std::vector<std::string> args = { "<PATH>", "--oocmd.sweep", "--oocmd.jobs=2", "--oocmd.sweep_output=" + path.string(), "--a=1,2,3", "--b=10", "--b=20", "--s=x,y" };
+        CHECK(run<Sweep>(args) == 7);
+
+        std::vector<nlohmann::json> results;
+        std::ifstream f(path);
+        std::string line;
+        while(std::getline(f, line)) results.push_back(nlohmann::json::parse(line));
+        std::filesystem::remove(path);
+
+        REQUIRE(results.size() == 6);
+        for(size_t i = 0; i < results.size(); i++) {
+            CHECK(results[i]["config"]["a"] == int(i / 2 + 1));
+            CHECK(results[i]["config"]["b"] == (i % 2 == 0 ? 10 : 20));
+            CHECK(results[i]["config"]["s"] == "x,y");
+            CHECK(results[i]["return"] == (i == 3 ? 7 : 0));
+        }
+    }
+
+    TEST_CASE("Benchmark") {
+        {
+            std::vector<double> v = { 5, 1, 4, 2, 3 };
+            auto const s = summarize(v);
+            CHECK(s.count == 5);
+            CHECK(s.min == 1);
+            CHECK(s.max == 5);
+            CHECK(s.median == 3);
+            CHECK(s.mad == 1);
+            CHECK(s.mean == 3);
+            CHECK(s.p90 == doctest::Approx(4.6));
+        }
+        {
+            auto const path = std::filesystem::temp_directory_path() / "oocmd-test-benchmark.jsonl";
+            std::vector<std::string> args = { "<PATH>", "--oocmd.sweep", "--oocmd.sweep_output=" + path.string(), "--oocmd.jobs=2", "--oocmd.repeat=3", "--oocmd.warmup=1", "--a=1,2", "--b=10" };
+            CHECK(run<Sweep>(args) == 0);
+
+            std::vector<nlohmann::json> results;
+            std::ifstream f(path);
+            std::string line;
+            while(std::getline(f, line)) results.push_back(nlohmann::json::parse(line));
+            std::filesystem::remove(path);
+
+            REQUIRE(results.size() == 2);
+            for(auto const& r : results) {
+                CHECK(r["iterations"].size() == 3);
+                CHECK(r["statistics"]["wall"]["count"] == 3);
+                CHECK(r["statistics"]["wall"]["min"] <= r["statistics"]["wall"]["median"]);
+            }
+        }
+    }
+
+    TEST_CASE("Profiler") {
+        {
+            Profiler disabled;
+            auto scope = disabled.phase("phase");
+            disabled.count("items");
+            CHECK(disabled.tree().empty());
+        }
+        {
+            auto const path = std::filesystem::temp_directory_path() / "oocmd-test-trace.json";
+            std::vector<std::string> args = { "<PATH>", "--oocmd.trace=" + path.string(), "--n=4" };
+            CHECK(run<Profiled>(args) == 0);
+
+            std::ifstream f(path);
+            auto const trace = nlohmann::json::parse(f);
+            std::filesystem::remove(path);
+
+            CHECK(trace["traceEvents"].size() == 5);
+            CHECK(trace["otherData"]["config"]["n"] == 4);
+        }
+        {
+            Profiler profiler(true);
+            {
+                auto outer = profiler.phase("outer");
+                for(int i = 0; i < 3; i++) {
+                    auto inner = profiler.phase("inner");
+                    profiler.count("items", 2);
+                }
+            }
+
+            auto const tree = profiler.tree();
+            REQUIRE(tree.size() == 1);
+            CHECK(tree[0]["name"] == "outer");
+            CHECK(tree[0]["count"] == 1);
+            REQUIRE(tree[0]["children"].size() == 1);
+            CHECK(tree[0]["children"][0]["name"] == "inner");
+            CHECK(tree[0]["children"][0]["count"] == 3);
+            CHECK(tree[0]["children"][0]["counters"]["items"] == 6);
+        }
+        {
+            // phases nested in a phase that is still open are ignored
+            Profiler profiler(true);
+            {
+                auto first = profiler.phase("first");
+            }
+            auto outer = profiler.phase("outer");
+            {
+                auto inner = profiler.phase("inner");
+            }
+
+            auto const tree = profiler.tree();
+            REQUIRE(tree.size() == 1);
+            CHECK(tree[0]["name"] == "first");
+
+            std::ostringstream out;
+            profiler.print_tree(out);
+            CHECK(out.str().find("inner") == std::string::npos);
+        }
+    }
+
+    TEST_CASE("Result lines") {
+        auto read_lines = [](std::filesystem::path const& path){
+            std::vector<std::string> lines;
+            std::ifstream f(path);
+            std::string line;
+            while(std::getline(f, line)) lines.push_back(line);
+            std::filesystem::remove(path);
+            return lines;
+        };
+
+        auto const path = std::filesystem::temp_directory_path() / "oocmd-test-results";
+        std::filesystem::remove(path);
+        {
+            CHECK(run<Measured>({ "<PATH>", "--oocmd.results=" + path.string(), "--a=3" }) == 0);
+            auto const lines = read_lines(path);
+            REQUIRE(lines.size() == 1);
+            CHECK(lines[0] == "RESULT a=3 object.x=false s=\"x y\" square=9 label=a,b");
+        }
+        {
+            CHECK(run<Measured>({ "<PATH>", "--oocmd.results=" + path.string(), "--oocmd.result_format=csv", "--oocmd.sweep", "--oocmd.jobs=2", "--a=1,2,3" }) == 0);
+            CHECK(run<Measured>({ "<PATH>", "--oocmd.results=" + path.string(), "--oocmd.result_format=csv", "--a=4" }) == 0);
+            auto const lines = read_lines(path);
+            REQUIRE(lines.size() == 5);
+            CHECK(lines[0] == "a,object.x,s,square,label");
+            CHECK(lines[4] == "4,false,x y,16,\"a,b\"");
+        }
+        {
+            CHECK(run<Measured>({ "<PATH>", "--oocmd.results=" + path.string(), "--oocmd.result_format=jsonl", "--a=5" }) == 0);
+            auto const lines = read_lines(path);
+            REQUIRE(lines.size() == 1);
+            auto const j = nlohmann::json::parse(lines[0]);
+            CHECK(j["a"] == 5);
+            CHECK(j["square"] == 25);
+            CHECK(j["object.x"] == false);
+        }
+        {
+            // CSV lines with different fields are rejected rather than appended under a mismatching header
+            ResultSink sink(ResultFormat::csv, path.string());
+            Measurements m;
+            m.record("time", 1);
+            std::string error;
+            CHECK(sink.write({ { "table", { { "@type", "HashA" }, { "load", 0.5 } } } }, m, &error));
+            CHECK(sink.write({ { "table", { { "@type", "HashA" }, { "load", 0.25 } } } }, m, &error));
+            CHECK(!sink.write({ { "table", { { "@type", "HashB" }, { "load", 0.5 }, { "probes", 1 } } } }, m, &error));
+            CHECK(error == "fields do not match the CSV header: table.@type,table.load,time");
+
+            auto const lines = read_lines(path);
+            REQUIRE(lines.size() == 3);
+            CHECK(lines[2] == "HashA,0.25,1");
+        }
+    }
+
+    TEST_CASE("Autotuning") {
+        // invalid progressions result in empty domains
+        CHECK(TuningDomain::range(0, 10, 0).empty());
+        CHECK(TuningDomain::range(0, 10, -1).empty());
+        CHECK(TuningDomain::range(INT64_MAX - 1, INT64_MAX, 2).values() == std::vector<std::string>{ std::to_string(INT64_MAX - 1) });
+        CHECK(TuningDomain::log_scale(1, 16, 1).empty());
+        CHECK(TuningDomain::log_scale(1, 16, 0).empty());
+        CHECK(TuningDomain::log_scale(0, 16).empty());
+        CHECK(TuningDomain::log_scale(1, 16).size() == 5);
+
+        auto const path = std::filesystem::temp_directory_path() / "oocmd-test-tuned.json";
+        for(auto const strategy : { "coordinate", "random", "halving" }) {
+            CHECK(run<Tuned>({ "<PATH>", "--oocmd.tune=100", "--oocmd.tune_objective=cost", std::string("--oocmd.tune_strategy=") + strategy,
+                        "--oocmd.tune_output=" + path.string(), "--object.x" }) == 0);
+
+            std::ifstream f(path);
+            auto const best = nlohmann::json::parse(f);
+            CHECK(best["object"]["x"] == true);
+            if(std::string(strategy) != "halving") {
+                // successive halving does not necessarily evaluate the optimum
+                CHECK(best["block"] == 16);
+                CHECK(best["offset"] == 1);
+            }
+        }
+
+        // explicitly assigned parameters are not tuned
+        CHECK(run<Tuned>({ "<PATH>", "--oocmd.tune=20", "--oocmd.tune_objective=cost", "--oocmd.tune_output=" + path.string(), "--offset=2" }) == 0);
+        {
+            std::ifstream f(path);
+            auto const best = nlohmann::json::parse(f);
+            CHECK(best["block"] == 16);
+            CHECK(best["offset"] == 2);
+        }
+
+        // load the tuned configuration, overriding a parameter
+        {
+            Tuned t;
+            std::vector<std::string> args = { "<PATH>", "--oocmd.config=" + path.string(), "--block=32" };
+            auto app = parse(t, args);
+            REQUIRE(app.good());
+            CHECK(t.block_ == 32);
+            CHECK(t.offset_ == 2);
+        }
+        std::filesystem::remove(path);
+
+        {
+            Autotuner tuner({ 10, 10 }, TuningStrategy::random, 1000, 42);
+            Autotuner::Point best;
+            CHECK(tuner.tune([](Autotuner::Point const& p){ return double(p[0] * p[1]); }, best) == 0);
+            CHECK(tuner.evaluations() == 100);
+        }
+    }
+
+    TEST_CASE("Lazy objects") {
+        {
+            std::vector<std::string> args = { "<PATH>" };
+            WithLazy w;
+            auto app = parse(w, args);
+            REQUIRE(app.good());
+            CHECK(!w.heavy_.constructed());
+            CHECK(Heavy::instances == 0);
+        }
+        {
+            std::vector<std::string> args = { "<PATH>", "--heavy.size=5" };
+            WithLazy w;
+            auto app = parse(w, args);
+            REQUIRE(app.good());
+            CHECK(w.heavy_.constructed());
+            CHECK(w.heavy_->size_ == 5);
+        }
+        {
+            std::vector<std::string> args = { "<PATH>", "--heavy.unknown=5" };
+            WithLazy w;
+            CHECK(!parse(w, args).good());
+            CHECK(!w.heavy_.constructed());
+        }
+        {
+            WithLazy w;
+            CHECK(w.config()["heavy"]["size"] == 1);
+            CHECK(!w.heavy_.constructed());
+
+            // const access reads the defaults without constructing the object
+            auto const& c = w;
+            CHECK(c.heavy_->size_ == 1);
+            CHECK(!w.heavy_.constructed());
+        }
+    }
+
+    TEST_CASE("Parse arena") {
+        ArenaStats reported;
+        Application::set_arena_hook([&](ArenaStats const& stats){ reported = stats; });
+
+        std::vector<std::string> args = { "<PATH>", "--int=5", "--object.x", "--unknown.param=1", "in" };
+        Test<A> a;
+        auto app = parse(a, args);
+        Application::set_arena_hook({});
+
+        CHECK(!app.good());
+        CHECK(app.arena_stats().allocations > 0);
+        CHECK(app.arena_stats().allocations <= 2);
+        CHECK(reported.bytes == app.arena_stats().bytes);
+    }
+
+    TEST_CASE("Interned metadata") {
+        Test<A> a, b;
+        CHECK(&a.type_name() == &b.type_name());
+        CHECK(&a.description() == &b.description());
+        CHECK(&a.get_param("int")->name() == &b.get_param("int")->name());
+        CHECK(&a.get_param("object")->description() == &b.get_param("object")->description());
+
+        // strings built at runtime share the pooled copy of an equal literal
+        std::string const name = std::string("in") + "t";
+        CHECK(&intern(name) == &a.get_param("int")->name());
+        CHECK(&intern("") == &a.get_param("int")->description());
+    }
+
+    TEST_CASE("Shared schema") {
+        Test<A> a, b;
+        CHECK(&a.schema() == &b.schema());
+        CHECK(a.get_param("uint") == b.get_param("uint"));
+
+        // values and annotations are kept per instance
+        a.configure({ { "int", 5 }, { "uint", "cores" }, { "object", { { "x", true } } } });
+        b.configure({ { "uint", "3" } });
+        CHECK(a.int_param_ == 5);
+        CHECK(b.int_param_ == 0);
+        CHECK(a.object_param_.x_);
+        CHECK(!b.object_param_.x_);
+        CHECK(a.config()["uint"].is_string());
+        CHECK(b.config()["uint"] == 3);
+
+        // derived types extend the schema of their base
+        Extended e;
+        A plain;
+        CHECK(&e.schema() != &plain.schema());
+        CHECK(e.get_param("x") == plain.get_param("x"));
+        CHECK(e.get_param("y"));
+        CHECK(!plain.get_param("y"));
+
+        e.configure({ { "x", true }, { "y", 3 } });
+        CHECK(e.x_);
+        CHECK(e.y_ == 3);
+        CHECK(!plain.x_);
+    }
+
+    TEST_CASE("Schema publication") {
+        // the schema is complete once the first instance has been constructed, and further instances share it rather than building their own
+        std::vector<Preset> v(1000);
+        auto const* schema = ConfigSchema::find(typeid(Preset));
+        CHECK(schema == &v.front().schema());
+        CHECK(&v.back().schema() == schema);
+
+        // an incomplete schema is discarded if the construction of the first instance fails
+        CHECK_THROWS(Fragile(true));
+        CHECK(!ConfigSchema::find(typeid(Fragile)));
+        Fragile f;
+        CHECK(f.get_param("a"));
+        CHECK(f.get_param("b"));
+
+        // defaults are those of each instance
+        Preset w1(1), w5(5);
+        w1.configure({ { "w", 3 } });
+        w5.configure({ { "w", 3 } });
+        w1.reset();
+        w5.reset();
+        CHECK(w1.w_ == 1);
+        CHECK(w5.w_ == 5);
+
+        Preset copy = w5;
+        copy.configure({ { "w", 3 } });
+        copy.reset();
+        CHECK(copy.w_ == 5);
+    }
+
+    TEST_CASE("Relocatable objects") {
+        static_assert(std::is_nothrow_move_constructible_v<Test<A>>);
+
+        // objects stay configurable after being relocated by a growing vector
+        std::vector<Test<A>> v;
+        for(int i = 0; i < 100; i++) {
+            v.emplace_back();
+            v.back().configure({ { "int", i }, { "object", { { "x", i % 2 == 1 } } } });
+        }
+        for(int i = 0; i < 100; i++) {
+            v[i].configure({ { "double", i * 0.5 } });
+            CHECK(v[i].config()["int"] == i);
+            CHECK(v[i].config()["object"]["x"] == (i % 2 == 1));
+            CHECK(v[i].double_param_ == i * 0.5);
+        }
+
+        // copies are configured independently, including their annotations and lazy objects
+        WithLazy a;
+        a.configure({ { "heavy", { { "size", 5 } } } });
+        WithLazy b = a;
+        b.configure({ { "heavy", { { "size", 9 } } } });
+        CHECK(a.heavy_->size_ == 5);
+        CHECK(b.heavy_->size_ == 9);
+
+        Test<A> c;
+        c.configure({ { "uint", "cores" } });
+        Test<A> d = c;
+        CHECK(d.config()["uint"] == c.config()["uint"]);
+        d.configure({ { "uint", 3 } });
+        CHECK(c.config()["uint"].is_string());
+        CHECK(d.config()["uint"] == 3);
+    }
+
+    TEST_CASE("Shell tokenizer") {
+        std::vector<std::string_view> tokens;
+        std::string buffer;
+        CHECK(tokenize_shell(R"(  plain --x='a b' "c \"d\"" e\ f '' )", tokens, buffer));
+        CHECK(tokens == std::vector<std::string_view>{ "plain", "--x=a b", "c \"d\"", "e f", "" });
+
+        CHECK(!tokenize_shell("'open", tokens, buffer));
+        CHECK(!tokenize_shell("trailing\\", tokens, buffer));
+    }
+
+    TEST_CASE("Reusable parser") {
+        Test<A> t;
+        Parser parser(t);
+
+        CHECK(parser.parse("--int=5 --string 'a b' in1 --object.x --stringlist=p --stringlist=q in2"));
+        CHECK(t.int_param_ == 5);
+        CHECK(t.string_param_ == "a b");
+        CHECK(t.object_param_.x_);
+        CHECK(t.stringlist_param_ == std::vector<std::string>{ "p", "q" });
+        CHECK(parser.args() == std::vector<std::string_view>{ "in1", "in2" });
+
+        // every parse starts from the defaults
+        CHECK(parser.parse("--uint=cores --enum=fast --double=0.5"));
+        CHECK(t.int_param_ == 0);
+        CHECK(t.string_param_.empty());
+        CHECK(!t.object_param_.x_);
+        CHECK(t.stringlist_param_.empty());
+        CHECK(t.uint_param_ == std::max(1U, machine::available_cores()));
+        CHECK(t.enum_param_ == Mode::fast);
+        CHECK(t.double_param_ == 0.5);
+        CHECK(parser.args().empty());
+
+        std::vector<std::string_view> tokens = { "--bytes=2Ki", "--bool=off", "--float", "1.5" };
+        CHECK(parser.parse(tokens));
+        CHECK(t.bytes_param_ == 2048);
+        CHECK(!t.bool_param_);
+        CHECK(t.float_param_ == 1.5f);
+        CHECK(t.config()["uint"] == 0);
+
+        char const* argv[] = { "<PATH>", "--int", "7", "file" };
+        CHECK(parser.parse(4, argv));
+        CHECK(t.int_param_ == 7);
+        CHECK(parser.args() == std::vector<std::string_view>{ "file" });
+
+        CHECK(!parser.parse("--unknown=1 --int=x --string"));
+        CHECK(parser.errors().size() == 3);
+
+        // choices are selected by type name and reset to the default alternative
+        Dispatch d;
+        Parser choices(d);
+        CHECK(choices.parse("--table=HashB --table.probes=3"));
+        CHECK(d.table_.holds<HashB>());
+        CHECK(d.table_.get<HashB>().probes_ == 3);
+        CHECK(choices.parse("--table.load=0.25"));
+        CHECK(d.table_.holds<HashA>());
+        CHECK(d.table_.get<HashA>().load_ == 0.25);
+        CHECK(!choices.parse("--table=HashC"));
+    }
+
+    TEST_CASE("Batch mode") {
+        auto const dir = std::filesystem::temp_directory_path();
+        auto const job_path = dir / "oocmd-test-batch.jobs";
+        auto const path = dir / "oocmd-test-batch.jsonl";
+        {
+            std::ofstream jobs(job_path);
+            jobs << "# comment\n";
+            for(int n = 1; n <= 8; n++) {
+                jobs << "--n=" << n << " --s 'job " << n << "' in" << n << "\n";
+                if(n == 4) jobs << "\n--m=1\n";
+            }
+        }
+
+        std::vector<std::string> args = { "<PATH>", "--oocmd.batch=" + job_path.string(), "--oocmd.parallel=3", "--oocmd.batch_output=" + path.string() };
+        CHECK(run<Job>(args) == 5);
+
+        std::vector<nlohmann::json> results;
+        std::ifstream f(path);
+        std::string line;
+        while(std::getline(f, line)) results.push_back(nlohmann::json::parse(line));
+        std::filesystem::remove(path);
+        std::filesystem::remove(job_path);
+
+        REQUIRE(results.size() == 9);
+        for(size_t i = 0; i < results.size(); i++) CHECK(results[i]["job"] == i);
+
+        CHECK(results[4]["line"] == 7);
+        CHECK(results[4]["return"] == -1);
+        CHECK(results[4]["errors"].size() == 1);
+
+        for(int n = 1; n <= 8; n++) {
+            auto const& r = results[n <= 4 ? n - 1 : n];
+            CHECK(r["config"]["n"] == n);
+            CHECK(r["return"] == (n == 3 ? 5 : 0));
+            CHECK(r["output"] == "job " + std::to_string(n) + ":" + std::to_string(n * n) + " in" + std::to_string(n));
+        }
+
+        // jobs start from the batch's configuration, and a throwing job is reported without holding up the following ones
+        {
+            std::ofstream jobs(job_path);
+            for(int n = 0; n <= 40; n++) jobs << (n == 1 ? "--n=-1" : "--n=" + std::to_string(n % 3)) << "\n";
+        }
+
+        args = { "<PATH>", "--s=shared", "--oocmd.batch=" + job_path.string(), "--oocmd.parallel=2", "--oocmd.batch_output=" + path.string() };
+        CHECK(run<Job>(args) == -1);
+
+        results.clear();
+        f = std::ifstream(path);
+        while(std::getline(f, line)) results.push_back(nlohmann::json::parse(line));
+        std::filesystem::remove(path);
+        std::filesystem::remove(job_path);
+
+        REQUIRE(results.size() == 41);
+        CHECK(results[1]["return"] == -1);
+        CHECK(results[1]["errors"].size() == 1);
+        CHECK(results[2]["config"]["s"] == "shared");
+        CHECK(results[2]["output"] == "shared:4");
+        CHECK(results[40]["return"] == 0);
+    }
+
+    TEST_CASE("Asynchronous run") {
+        {
+            std::vector<std::string> args = { "<PATH>", "--n=4" };
+            CHECK(run<Async>(args) == 10);
+        }
+        {
+            std::vector<std::string> args = { "<PATH>", "--oocmd.sweep", "--oocmd.jobs=2", "--oocmd.sweep_output=/dev/null", "--n=1,2,3" };
+            CHECK(run<Async>(args) == 1);
+        }
+        {
+            std::vector<std::string> args = { "<PATH>" };
+            CHECK(run<Stalled>(args) == -1);
+        }
+        {
+            // an exception escaping a spawned task propagates out of the run, and subsequent runs are unaffected
+            std::vector<std::string> args = { "<PATH>" };
+            CHECK_THROWS_AS(run<Throwing>(args), std::runtime_error);
+            CHECK(run<Async>(args) == 6);
+        }
+
+        EventLoop loop;
+        auto delayed = [&](int const v) -> Task<int> {
+            co_await loop.sleep_for(std::chrono::milliseconds(2));
+            co_return v;
+        };
+        auto sum = [&]() -> Task<int> {
+            co_return (co_await delayed(1)) + (co_await delayed(2));
+        };
+        auto task = sum();
+        REQUIRE(loop.run(task));
+        CHECK(task.result() == 3);
+    }
+
+    TEST_CASE("Control socket") {
+        auto const path = std::filesystem::temp_directory_path() / "oocmd-test-control.sock";
+        std::vector<std::string> args = { "<PATH>", "--oocmd.control=" + path.string(), "--object.x" };
+        Live x;
+        CHECK(run(x, args) == 16);
+        CHECK(!std::filesystem::exists(path));
+
+        REQUIRE(x.responses_.size() == 9);
+        CHECK(x.responses_[0] == "ok 4");
+        CHECK(x.responses_[1] == "ok");
+        CHECK(x.responses_[2] == "ok");
+        CHECK(x.responses_[3] == "ok");
+        CHECK(x.responses_[4] == "error parameter is not live: fixed");
+        CHECK(x.responses_[5] == "error invalid value: shards=x");
+        CHECK(x.responses_[6] == "ok true");
+        CHECK(x.responses_[7] == "error unknown command: frob");
+        CHECK(nlohmann::json::parse(x.responses_[8].substr(3)) == nlohmann::json{ { "shards", 16 }, { "verbose", true }, { "ratio", 0.25 }, { "object.x", true } });
+
+        CHECK(x.verbose_.load());
+        CHECK(x.ratio_.load() == 0.25);
+
+        // live parameters are configured and listed like any other
+        x.configure({ { "shards", "8" }, { "ratio", 1 } });
+        CHECK(x.shards_.load() == 8);
+        CHECK(x.ratio_.load() == 1.0);
+        x.reset();
+        CHECK(x.shards_.load() == 4);
+
+        std::ostringstream usage;
+        print_usage(usage, x);
+        CHECK(usage.str().find("(32-bit non-negative integer, default: 4, live)") != std::string::npos);
+
+        // lazy objects are never constructed by the server
+        struct WithLazyLive : public ConfigObject {
+            Lazy<Live> live_;
+
+            WithLazyLive() : ConfigObject("WithLazyLive", "An object with a lazy live member") {
+                param("live", live_);
+            }
+        } y;
+
+        ControlServer server(y, path.string());
+        REQUIRE(server.good());
+        CHECK(server.execute("get live.shards") == "ok 4");
+        CHECK(server.execute("set live.shards=8") == "error parameter belongs to an object that has not been constructed: live.shards");
+        CHECK(!y.live_.constructed());
+
+        y.live_.get();
+        CHECK(server.execute("set live.shards=8") == "ok");
+        CHECK(server.execute("get live.shards") == "ok 8");
+        CHECK(y.live_.get().shards_.load() == 8);
+    }
+
+    TEST_CASE("Parameter handles") {
+        Measured m;
+        m.configure({ { "a", 3 }, { "object", { { "x", true } } } });
+
+        auto a = m.handle<int>("a");
+        REQUIRE(a);
+        CHECK(a.get() == 3);
+        m.a_ = 4;
+        CHECK(*a == 4);
+
+        auto x = m.handle<bool>("object.x");
+        REQUIRE(x);
+        CHECK(x.get());
+
+        auto object = m.handle<A>("object");
+        REQUIRE(object);
+        CHECK(&object.get() == &m.object_);
+
+        std::string error;
+        CHECK(!m.handle<double>("a", &error));
+        CHECK(error == "parameter is not of the requested type: a");
+        CHECK(!m.handle<int>("object.y", &error));
+        CHECK(error == "unknown parameter: object.y");
+        CHECK(!m.handle<int>("a.b"));
+        CHECK(!m.handle<HashA>("object"));
+
+        // live parameters are accessed via their atomic variables
+        Live live;
+        auto shards = live.handle<std::atomic<unsigned int>>("shards");
+        REQUIRE(shards);
+        live.configure({ { "shards", 12 } });
+        CHECK(shards->load(std::memory_order_relaxed) == 12);
+        CHECK(!live.handle<unsigned int>("shards"));
+
+        // handles resolve the selected alternative of a choice and construct lazy objects
+        Dispatch d;
+        d.configure({ { "table", { { "@type", "HashB" }, { "probes", 3 } } } });
+        auto probes = d.handle<int>("table.probes");
+        REQUIRE(probes);
+        CHECK(probes.get() == 3);
+        CHECK(d.handle<HashB>("table"));
+
+        WithLazy w;
+        auto heavy = w.handle<Heavy>("heavy");
+        REQUIRE(heavy);
+        CHECK(w.heavy_.constructed());
+        CHECK(&heavy.get() == &w.heavy_.get());
+    }
+
+    TEST_CASE("Layered configuration") {
+        {
+            ConfigLayers layers;
+            layers.push("defaults", { { "a", "1" }, { "s", "x" }, { "object", { { "x", "true" } } } });
+            layers.push("command line", { { "a", "2" } });
+
+            Measured m;
+            m.configure(layers);
+            CHECK(m.a_ == 2);
+            CHECK(m.s_ == "x");
+            CHECK(m.object_.x_);
+            CHECK(m.provenance("a") == "command line");
+            CHECK(m.provenance("s") == "defaults");
+            CHECK(m.object_.provenance("x") == "defaults");
+            CHECK(provenance_config(m) == nlohmann::json{ { "a", "command line" }, { "s", "defaults" }, { "object.x", "defaults" } });
+            CHECK(layers.merged() == nlohmann::json{ { "a", "2" }, { "s", "x" }, { "object", { { "x", "true" } } } });
+
+            // configuring otherwise forgets the provenance
+            m.configure({ { "a", 5 } });
+            CHECK(m.provenance("a").empty());
+            CHECK(m.provenance("s") == "defaults");
+            m.reset();
+            CHECK(m.object_.provenance("x").empty());
+        }
+
+        // the topmost layer selecting an alternative wins, and lower layers configure it only if they select the same one
+        {
+            ConfigLayers layers;
+            layers.push("base", { { "table", { { "@type", "HashA" }, { "load", "0.1" } } } });
+            layers.push("file", { { "table", { { "@type", "HashB" }, { "probes", "3" } } } });
+            layers.push("command line", { { "table", { { "load", "0.9" } } } });
+
+            Dispatch d;
+            d.configure(layers);
+            REQUIRE(d.table_.holds<HashB>());
+            auto const& b = d.table_.get<HashB>();
+            CHECK(b.probes_ == 3);
+            CHECK(b.load_ == 0.9);
+            CHECK(provenance_config(d) == nlohmann::json{ { "table", "file" }, { "table.probes", "file" }, { "table.load", "command line" } });
+        }
+
+        // applications layer the command line above a configuration file
+        {
+            auto const path = std::filesystem::temp_directory_path() / "oocmd-test-layers.json";
+            {
+                std::ofstream f(path);
+                f << nlohmann::json{ { "a", 1 }, { "s", "from file" } }.dump();
+            }
+
+            Measured m;
+            std::vector<std::string> args = { "<PATH>", "--oocmd.config=" + path.string(), "--a=3" };
+            auto app = parse(m, args);
+            std::filesystem::remove(path);
+            REQUIRE(app.good());
+            CHECK(m.a_ == 3);
+            CHECK(m.s_ == "from file");
+            CHECK(m.provenance("a") == "command line");
+            CHECK(m.provenance("s") == "file " + path.string());
+
+            std::ostringstream usage;
+            print_usage(usage, m);
+            CHECK(usage.str().find(", set by file " + path.string() + ")") != std::string::npos);
+        }
+
+        // the command line configures the alternatives selected by a configuration file
+        {
+            auto const path = std::filesystem::temp_directory_path() / "oocmd-test-layers-choice.json";
+            {
+                std::ofstream f(path);
+                f << nlohmann::json{ { "table", { { "@type", "HashB" }, { "probes", 3 } } } }.dump();
+            }
+
+            auto configure = [&](std::string const& arg){
+                Dispatch d;
+                std::vector<std::string> args = { "<PATH>", "--oocmd.config=" + path.string(), arg };
+                auto app = parse(d, args);
+                REQUIRE(app.good());
+                REQUIRE(d.table_.holds<HashB>());
+                return d.table_.get<HashB>();
+            };
+
+            auto const b = configure("--table.probes=5");
+            CHECK(b.probes_ == 5);
+            CHECK(b.provenance("probes") == "command line");
+
+            auto const c = configure("--table.load=0.9");
+            CHECK(c.probes_ == 3);
+            CHECK(c.load_ == 0.9);
+            CHECK(c.provenance("probes") == "file " + path.string());
+
+            Dispatch d;
+            std::vector<std::string> args = { "<PATH>", "--oocmd.config=" + path.string(), "--table=HashA", "--table.load=0.1" };
+            auto app = parse(d, args);
+            std::filesystem::remove(path);
+            REQUIRE(app.good());
+            REQUIRE(d.table_.holds<HashA>());
+            CHECK(d.table_.get<HashA>().load_ == 0.1);
+        }
+    }
+
+    TEST_CASE("Specialized dispatch") {
+        CHECK(run<Blocked>({ "<PATH>" }) == 64);
+        CHECK(run<Blocked>({ "<PATH>", "--block=256" }) == 256);
+        CHECK(run<Blocked>({ "<PATH>", "-b", "100" }) == -100);
+    }
 }
 
 }